@@ -0,0 +1,286 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Nodes Run                                                                       *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+// Runs a project without a window, at full speed, and writes the signals to a csv file.
+// With --sweep, runs the project once per parameter set and writes the final signals of every run.
+
+#include "CoreGraph.hpp"
+#include "CoreSimulation.hpp"
+#include "CoreSweep.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static void PrintUsage()
+{
+    std::cout << "Usage: core-nodes-run <project.dxdt> [options]\n"
+                 "  -o <file>          Output file. Default is the project name with .csv extension.\n"
+                 "  --solver <name>    Overrides the solver of the project.\n"
+                 "  --sample <time>    Overrides the sample time.\n"
+                 "  --stop <time>      Overrides the stop time.\n"
+                 "  -q                 Does not print the summary.\n"
+                 "  --sweep <spec>     Varies a parameter, repeatable. <spec> is one of\n"
+                 "                       Node.param=range:<from>:<to>:<points>\n"
+                 "                       Node.param=uniform:<min>:<max>\n"
+                 "                       Node.param=normal:<mean>:<sigma>\n"
+                 "  --runs <n>         Random draws per grid point. Default is 100.\n"
+                 "  --seed <n>         Seed of the random draws. Default is 1.\n"
+                 "  --threads <n>      Worker threads. Default is every hardware thread.\n";
+}
+
+static void WriteSample(std::ofstream& file, double t, const CoreProgram& program)
+{
+    char buffer[32];
+    std::string line;
+    std::snprintf(buffer, sizeof(buffer), "%.15g", t);
+    line += buffer;
+    const auto& signals = program.GetSignals();
+    for (size_t i = 1; i < signals.size(); i++)
+    {
+        std::snprintf(buffer, sizeof(buffer), ",%.15g", signals[i]);
+        line += buffer;
+    }
+    line += '\n';
+    file << line;
+}
+
+static int RunSweep(const CoreProgram& program, const SimSettings& settings, const std::vector<SweepParam>& sweepParams, long long runs,
+    unsigned long long seed, int threadNum, const std::filesystem::path& outputPath, bool quiet)
+{
+    CoreSweep sweep;
+    if (sweep.Init(program, settings, sweepParams, runs, seed) == false)
+    {
+        std::cerr << "Error: " << sweep.GetError() << std::endl;
+        return 1;
+    }
+    CorePool pool(threadNum);
+    if (sweep.Run(pool) == false)
+    {
+        std::cerr << "Error: " << sweep.GetError() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file(outputPath);
+    if (file.is_open() == false)
+    {
+        std::cerr << "Error: Cannot open " << outputPath.string() << std::endl;
+        return 1;
+    }
+    file << "run";
+    for (const auto& param : sweep.GetParams())
+    {
+        file << "," << param.name;
+    }
+    for (int i = 1; i < program.GetSignalNum(); i++)
+    {
+        file << "," << program.GetSignalName(i);
+    }
+    file << "\n";
+    char buffer[32];
+    for (long long run = 0; run < sweep.GetRunNum(); run++)
+    {
+        std::string line = std::to_string(run);
+        const double* row = sweep.GetRow(run);
+        for (int i = 0; i < sweep.GetRowSize(); i++)
+        {
+            std::snprintf(buffer, sizeof(buffer), ",%.15g", row[i]);
+            line += buffer;
+        }
+        line += '\n';
+        file << line;
+    }
+    file.close();
+
+    if (quiet == false)
+    {
+        std::cout << sweep.GetRunNum() << " runs (" << sweep.GetFailedNum() << " failed) on " << pool.GetThreadNum() << " threads in " <<
+            sweep.GetElapsed() << " s -> " << outputPath.string() << "\n";
+        std::printf("%-24s %14s %14s %14s %14s %14s %14s\n", "signal", "final mean", "final std", "final min", "final max", "min", "max");
+        const auto& summary = sweep.GetSummary();
+        for (int i = 1; i < program.GetSignalNum(); i++)
+        {
+            const auto& s = summary[i];
+            std::printf("%-24s %14.6g %14.6g %14.6g %14.6g %14.6g %14.6g\n", program.GetSignalName(i).c_str(), s.final.mean,
+                s.final.GetStd(), s.final.min, s.final.max, s.trajMin, s.trajMax);
+        }
+    }
+    return sweep.GetFailedNum() == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    Notifier::SetConsole(true);
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+    std::filesystem::path inputPath = argv[1];
+    std::filesystem::path outputPath = std::filesystem::path(inputPath).replace_extension(".csv");
+    std::string solverName;
+    double sampleTime = 0.0;
+    double stopTime = -1.0;
+    bool quiet = false;
+    std::vector<SweepParam> sweepParams;
+    long long runs = 100;
+    unsigned long long seed = 1;
+    int threadNum = 0;
+    for (int i = 2; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue)
+        {
+            outputPath = argv[++i];
+        }
+        else if (arg == "--solver" && hasValue)
+        {
+            solverName = argv[++i];
+        }
+        else if (arg == "--sample" && hasValue)
+        {
+            sampleTime = std::atof(argv[++i]);
+        }
+        else if (arg == "--stop" && hasValue)
+        {
+            stopTime = std::atof(argv[++i]);
+        }
+        else if (arg == "-q")
+        {
+            quiet = true;
+        }
+        else if (arg == "--sweep" && hasValue)
+        {
+            SweepParam param;
+            if (SweepParam::Parse(argv[++i], param) == false)
+            {
+                std::cerr << "Error: Invalid sweep " << argv[i] << std::endl;
+                return 1;
+            }
+            sweepParams.push_back(param);
+        }
+        else if (arg == "--runs" && hasValue)
+        {
+            runs = std::atoll(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--threads" && hasValue)
+        {
+            threadNum = std::atoi(argv[++i]);
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // Binary and XML projects share the extension, the magic bytes tell them apart.
+    CoreBinaryReader reader;
+    pugi::xml_document doc;
+    pugi::xml_node root;
+    const bool binary = CoreBinaryReader::IsBinary(inputPath.string());
+    if (binary == true)
+    {
+        if (reader.Open(inputPath.string()) == false)
+        {
+            std::cerr << "Error: Load failed " << inputPath.string() << ", " << reader.GetError() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        pugi::xml_parse_result result = doc.load_file(inputPath.string().c_str(), pugi::parse_default | pugi::parse_declaration);
+        if (!result)
+        {
+            std::cerr << "Error: Load failed " << inputPath.string() << std::endl;
+            return 1;
+        }
+        root = doc.document_element();
+    }
+    SimSettings settings;
+    binary == true ? settings.Load(reader) : settings.Load(root);
+    if (solverName.empty() == false)
+    {
+        auto it = std::find(solverTypeNames.begin() + 1, solverTypeNames.end(), solverName);
+        if (it == solverTypeNames.end())
+        {
+            std::cerr << "Error: Unknown solver " << solverName << std::endl;
+            return 1;
+        }
+        settings.solver = static_cast<SolverType>(it - solverTypeNames.begin());
+    }
+    if (sampleTime > 0.0)
+    {
+        settings.sampleTime = sampleTime;
+    }
+    if (stopTime >= 0.0)
+    {
+        settings.stopTime = stopTime;
+    }
+
+    CoreGraph graph;
+    binary == true ? graph.Load(reader) : graph.Load(root);
+    CoreProgram program;
+    if (graph.Compile(program) == false)
+    {
+        return 1;
+    }
+    if (sweepParams.empty() == false)
+    {
+        return RunSweep(program, settings, sweepParams, runs, seed, threadNum, outputPath, quiet);
+    }
+
+    CoreSimulation simulation;
+    if (simulation.Init(program, settings) == false)
+    {
+        std::cerr << "Error: " << simulation.GetError() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file(outputPath);
+    if (file.is_open() == false)
+    {
+        std::cerr << "Error: Cannot open " << outputPath.string() << std::endl;
+        return 1;
+    }
+    file << "time";
+    for (int i = 1; i < program.GetSignalNum(); i++)
+    {
+        file << "," << program.GetSignalName(i);
+    }
+    file << "\n";
+
+    auto start = std::chrono::steady_clock::now();
+    WriteSample(file, simulation.GetTime(), simulation.GetProgram());
+    while (simulation.Step() == true)
+    {
+        WriteSample(file, simulation.GetTime(), simulation.GetProgram());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    file.close();
+    if (simulation.GetError().empty() == false)
+    {
+        std::cerr << "Error: " << simulation.GetError() << std::endl;
+        return 1;
+    }
+    if (quiet == false)
+    {
+        std::cout << inputPath.filename().string() << ": " << solverTypeNames.at(static_cast<int>(settings.solver)) << ", " <<
+            simulation.GetStepNum() << " samples, " << program.GetStateNum() << " states in " << elapsed.count() << " s -> " <<
+            outputPath.string() << std::endl;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Nodes Test                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+// Checks of the model library, run by ctest. Returns non-zero if a check fails.
+
+#include "CoreGraph.hpp"
+#include "CoreJournal.hpp"
+#include "CoreProgram.hpp"
+#include "CoreSweep.hpp"
+#include <cmath>
+#include <iostream>
+#include <string>
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& message)
+{
+    if (condition == false)
+    {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures += 1;
+    }
+}
+
+// Exposes the editing functions of the graph.
+class TestGraph : public CoreGraph
+{
+public:
+    CoreNode* Add(const std::string& libName, const std::string& name)
+    {
+        CoreNode* node = CreateNode(nodePool, libName, name);
+        node->Build();
+        AddNode(node);
+        return node;
+    }
+    void Connect(CoreNode* outputNode, int outputPort, CoreNode* inputNode, int inputPort)
+    {
+        Link link{};
+        link.outputNode = outputNode;
+        link.inputNode = inputNode;
+        link.outputPort = &outputNode->GetOutputVec().at(outputPort);
+        link.inputPort = &inputNode->GetInputVec().at(inputPort);
+        AddLink(link);
+    }
+    void Disconnect(CoreNode* inputNode, int inputPort)
+    {
+        CoreNodeInput* input = &inputNode->GetInputVec().at(inputPort);
+        input->BreakLink();
+        EraseLink(input);
+    }
+    void BringToFront(CoreNode* node)
+    {
+        coreNodeVec.erase(std::find(coreNodeVec.begin(), coreNodeVec.end(), node));
+        coreNodeVec.push_back(node);
+        IndexNodeOrder();
+    }
+    std::vector<const CoreNodeInput*> GetRoutedInputs() // Inputs of the links routed again, in routing order.
+    {
+        std::vector<const CoreNodeInput*> inputs;
+        for (const auto& i : GetRoutingAffectedLinks())
+        {
+            inputs.push_back(linkVec.at(i).inputPort);
+        }
+        return inputs;
+    }
+    int GetExeIndex(const CoreNode* node) const { return exeIndex.at(node); }
+};
+
+static double GetSignal(const CoreProgram& program, const std::string& name)
+{
+    for (int i = 0; i < program.GetSignalNum(); i++)
+    {
+        if (program.GetSignalName(i) == name)
+        {
+            return program.GetSignals()[i];
+        }
+    }
+    return NAN;
+}
+
+// The source of an initial condition is added after the integrator, linking it must move it ahead.
+static void TestIcSourceOrder()
+{
+    TestGraph graph;
+    CoreNode* target = graph.Add("Integrator", "Target");
+    CoreNode* gain = graph.Add("Gain", "Gain");
+    CoreNode* source = graph.Add("Integrator", "Source");
+    gain->GetParams().at(0)->Set(3.0);
+    source->GetParams().at(0)->Set(2.0);
+    graph.Connect(source, 0, gain, 0);
+    graph.Connect(gain, 0, target, 1);  // Ic
+    graph.Connect(target, 0, source, 0); // Feeds the state only, no loop.
+
+    Check(graph.GetExeIndex(source) < graph.GetExeIndex(gain), "Ic source runs before the gain.");
+    Check(graph.GetExeIndex(gain) < graph.GetExeIndex(target), "Ic gain runs before the integrator.");
+
+    CoreProgram program;
+    Check(graph.Compile(program) == true, "Compiles.");
+    std::vector<double> x(program.GetStateNum(), -1.0);
+    program.Initialize(0.0, x.data());
+    Check(GetSignal(program, "Target.Output") == 6.0, "Initial state of the integrator is read from its Ic source.");
+
+    // A second run starts from the same state, not from the signals of the first one.
+    program.Outputs(0.0, x.data());
+    std::vector<double> y(program.GetStateNum(), -1.0);
+    program.Initialize(0.0, y.data());
+    Check(x == y, "Initialization does not depend on the previous run.");
+}
+
+// Every run starts from the initial condition of its own parameters, and a diverging run is left out.
+static void TestSweepRuns()
+{
+    TestGraph graph;
+    CoreNode* target = graph.Add("Integrator", "Target");
+    CoreNode* gain = graph.Add("Gain", "Gain");
+    CoreNode* source = graph.Add("Integrator", "Source");
+    graph.Connect(source, 0, gain, 0);
+    graph.Connect(gain, 0, target, 1);
+    graph.Connect(gain, 0, source, 0); // x' = gain * x
+
+    CoreProgram program;
+    Check(graph.Compile(program) == true, "Compiles.");
+    SimSettings settings;
+    settings.solver = SolverType::Euler;
+    settings.stopTime = 1.0;
+    settings.sampleTime = 0.1;
+    std::vector<SweepParam> params(2);
+    Check(SweepParam::Parse("Source.ic=range:1:3:3", params[0]) == true, "Parses the range of ic.");
+    Check(SweepParam::Parse("Gain.gain=range:1e300:0:2", params[1]) == true, "Parses the range of gain.");
+    CoreSweep sweep;
+    Check(sweep.Init(program, settings, params, 1, 1) == true, "Finds the parameters by name.");
+    CorePool pool(1);                   // One simulation runs every point.
+    Check(sweep.Run(pool) == true, "Runs.");
+
+    Check(sweep.GetRunNum() == 6 && sweep.GetFailedNum() == 3, "The runs with the huge gain diverge.");
+    int sourceSignal = -1;
+    int targetSignal = -1;
+    for (int i = 1; i < program.GetSignalNum(); i++)
+    {
+        sourceSignal = program.GetSignalName(i) == "Source.Output" ? i : sourceSignal;
+        targetSignal = program.GetSignalName(i) == "Target.Output" ? i : targetSignal;
+    }
+    for (long long run = 3; run < 6; run++)
+    {
+        // The diverged runs went first on the same simulation. Gain is zero now, the states stay.
+        const double* row = sweep.GetRow(run);
+        Check(row[params.size() + sourceSignal - 1] == static_cast<double>(run - 2), "Source keeps the ic of its own run.");
+        Check(row[params.size() + targetSignal - 1] == 0.0, "Target starts from the Ic signal of its own run.");
+    }
+    const SweepSummary& summary = sweep.GetSummary().at(targetSignal);
+    Check(std::isfinite(summary.trajMin) && std::isfinite(summary.trajMax), "Diverged runs are not in the envelope.");
+}
+
+// Moving a node reroutes the links sharing a node side with its links, and no others.
+static void TestRoutingAffectedLinks()
+{
+    TestGraph graph;
+    CoreNode* a = graph.Add("Gain", "A");
+    CoreNode* b = graph.Add("Gain", "B");
+    CoreNode* c = graph.Add("Gain", "C");
+    CoreNode* d = graph.Add("Gain", "D");
+    CoreNode* e = graph.Add("Gain", "E");
+    graph.Connect(a, 0, b, 0);
+    graph.Connect(d, 0, e, 0);
+    graph.Connect(b, 0, c, 0);
+    Check(graph.GetRoutedInputs().size() == 3, "The first routing covers every link.");
+    Check(graph.GetRoutedInputs().empty() == true, "Nothing is rerouted when nothing changed.");
+
+    graph.NodeMoved(b);
+    auto inputs = graph.GetRoutedInputs();
+    auto has = [&inputs](const CoreNode* node) { return std::find(inputs.begin(), inputs.end(), &node->GetInputVec()[0]) != inputs.end(); };
+    Check(inputs.size() == 2 && has(b) == true && has(c) == true, "Links of the moved node are rerouted.");
+
+    graph.Disconnect(b, 0);
+    graph.GetRoutedInputs();
+    graph.NodeMoved(d);
+    inputs = graph.GetRoutedInputs();
+    Check(inputs.size() == 1 && has(e) == true, "Links are found after a link before them is erased.");
+    graph.NodeMoved(c);
+    inputs = graph.GetRoutedInputs();
+    Check(inputs.size() == 1 && has(c) == true, "The link moved into the erased slot is found.");
+
+    graph.BringToFront(c);
+    graph.NodeMoved(c);
+    graph.NodeMoved(e);
+    inputs = graph.GetRoutedInputs();
+    Check(inputs.size() == 2 && inputs[0] == &c->GetInputVec()[0], "The z-order does not change the routing order.");
+}
+
+// Adds to a value, refused while the value is the blocked one.
+class AddCommand : public CoreCommand
+{
+private:
+    int& value;
+    const int& blocked;
+    int amount;
+
+public:
+    AddCommand(int& value, const int& blocked, int amount) : value(value), blocked(blocked), amount(amount) {}
+    void Undo() override { value -= amount; }
+    void Redo() override { value += amount; }
+    bool IsValid([[maybe_unused]] bool redo) const override { return value != blocked; }
+    size_t GetMemory() const override { return sizeof(*this); }
+    void Write([[maybe_unused]] RecoveryRecord& record) const override {}
+};
+
+// A step that cannot be applied in full is left as it was.
+static void TestJournalRollback()
+{
+    int value = 7;
+    int blocked = 1;
+    CoreJournal journal;
+    journal.Record(std::make_unique<AddCommand>(value, blocked, 1));
+    journal.Record(std::make_unique<AddCommand>(value, blocked, 2));
+    journal.Record(std::make_unique<AddCommand>(value, blocked, 4));
+    journal.Commit();
+    Check(journal.Undo() == false && value == 7 && journal.CanUndo() == true, "A refused undo leaves the step applied.");
+    blocked = -1;
+    Check(journal.Undo() == true && value == 0, "The step is undone.");
+    blocked = 3;
+    Check(journal.Redo() == false && value == 0 && journal.CanRedo() == true, "A refused redo leaves the step reverted.");
+    blocked = -1;
+    Check(journal.Redo() == true && value == 7, "The step is redone.");
+}
+
+int main()
+{
+    TestIcSourceOrder();
+    TestSweepRuns();
+    TestRoutingAffectedLinks();
+    TestJournalRollback();
+    if (failures == 0)
+    {
+        std::cout << "All checks passed." << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
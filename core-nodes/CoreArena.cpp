@@ -0,0 +1,98 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Arena                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreArena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+CoreArena::CoreArena(size_t initialSize) : blockSize(initialSize)
+{
+    blocks.push_back(Block{ std::make_unique<unsigned char[]>(blockSize), blockSize });
+}
+
+void* CoreArena::Allocate(size_t size, size_t align)
+{
+    while (true)
+    {
+        Block& block = blocks[blockIndex];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const size_t begin = ((base + used + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1)) - base;
+        if (begin + size <= block.size)
+        {
+            peak += begin + size - used;
+            used = begin + size;
+            return block.data.get() + begin;
+        }
+        // Next block, at least twice the size of the last one.
+        peak += block.size - used;
+        blockIndex += 1;
+        used = 0;
+        if (blockIndex == blocks.size())
+        {
+            const size_t newSize = std::max(blocks.back().size * 2, size + align);
+            blocks.push_back(Block{ std::make_unique<unsigned char[]>(newSize), newSize });
+        }
+    }
+}
+
+void CoreArena::Reset()
+{
+    if (blocks.size() > 1)
+    {
+        // The frame did not fit, the next ones get a single block of the whole size.
+        const size_t total = GetCapacity();
+        blocks.clear();
+        blocks.push_back(Block{ std::make_unique<unsigned char[]>(total), total });
+    }
+    blockIndex = 0;
+    used = 0;
+    peak = 0;
+}
+
+size_t CoreArena::GetCapacity() const
+{
+    size_t capacity = 0;
+    for (const auto& block : blocks)
+    {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+// Counting replacement of the global allocation functions. The array and nothrow forms of the
+// standard library forward to these. ImGui allocates through its own allocator, it is not counted.
+static std::atomic<long long> heapAllocNum{ 0 };
+
+long long GetHeapAllocNum()
+{
+    return heapAllocNum.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    heapAllocNum.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
\ No newline at end of file
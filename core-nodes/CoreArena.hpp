@@ -0,0 +1,73 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Arena                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREARENA_HPP
+#define COREARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <unordered_set>
+
+// Bump allocator for the transient data of a frame. Memory is handed out linearly and released
+// all at once by Reset, so the containers built on it never free and never reach the heap once warm.
+class CoreArena
+{
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t blockIndex = 0;
+    size_t used = 0;                        // In the current block.
+    size_t blockSize;
+    size_t peak = 0;                        // Bytes used since the last reset.
+
+public:
+    explicit CoreArena(size_t initialSize = 64 * 1024);
+    CoreArena(const CoreArena&) = delete;
+    CoreArena& operator=(const CoreArena&) = delete;
+    virtual ~CoreArena() = default;
+    void* Allocate(size_t size, size_t align);
+    void Reset();                           // Start of the frame. Grown arenas are merged into one block.
+    size_t GetCapacity() const;
+    size_t GetPeak() const { return peak; }
+};
+
+// Standard allocator over an arena, deallocate is a no-op.
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    CoreArena* arena;
+    explicit ArenaAllocator(CoreArena& frameArena) : arena(&frameArena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+    T* allocate(size_t n) { return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template<typename T>
+using ArenaSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, ArenaAllocator<T>>;
+
+// Calls to the global operator new since the start of the program, to check that a frame does not allocate.
+long long GetHeapAllocNum();
+
+#endif /* COREARENA_HPP */
\ No newline at end of file
@@ -0,0 +1,315 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Binary                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreBinary.hpp"
+#include "CoreNode.hpp"
+#include <cstdio>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const size_t recordSize[static_cast<int>(BinaryTable::Num)] =
+{
+    sizeof(BinaryNode), sizeof(BinaryPort), sizeof(BinaryPort), sizeof(BinaryParam), sizeof(BinaryLink), sizeof(uint32_t), 1
+};
+
+BinaryString CoreBinaryWriter::AddString(const std::string& str)
+{
+    auto it = stringIndex.find(str);
+    if (it != stringIndex.end())
+    {
+        return it->second;
+    }
+    const BinaryString ref{ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size()) };
+    strings += str;
+    stringIndex.emplace(str, ref);
+    return ref;
+}
+
+std::string CoreBinaryWriter::GetData()
+{
+    std::string file(sizeof(BinaryHeader), '\0');
+    const void* tables[] = { nodes.data(), inputs.data(), outputs.data(), params.data(), links.data(), exeOrder.data(), strings.data() };
+    const size_t counts[] = { nodes.size(), inputs.size(), outputs.size(), params.size(), links.size(), exeOrder.size(), strings.size() };
+    for (int i = 0; i < static_cast<int>(BinaryTable::Num); i++)
+    {
+        file.resize((file.size() + 7) / 8 * 8, '\0'); // Tables start on 8 bytes.
+        header.tableOffset[i] = file.size();
+        header.tableCount[i] = counts[i];
+        file.append(static_cast<const char*>(tables[i]), counts[i] * recordSize[i]);
+    }
+    std::memcpy(file.data(), &header, sizeof(BinaryHeader));
+    return file;
+}
+
+CoreBinaryReader::~CoreBinaryReader()
+{
+    Close();
+}
+
+void CoreBinaryReader::Close()
+{
+#if defined(_WIN32)
+    if (data != nullptr && mapping != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(mapping));
+    }
+    if (file != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(file));
+    }
+#else
+    if (data != nullptr && mapping != nullptr)
+    {
+        munmap(mapping, size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    mapping = nullptr;
+    file = nullptr;
+}
+
+bool CoreBinaryReader::Open(const std::string& path)
+{
+    Close();
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        error = "Cannot open " + path;
+        return false;
+    }
+    file = handle;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(handle, &fileSize) == FALSE || fileSize.QuadPart == 0)
+    {
+        error = "Cannot read " + path;
+        Close();
+        return false;
+    }
+    mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping != nullptr ? MapViewOfFile(static_cast<HANDLE>(mapping), FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr)
+    {
+        error = "Cannot map " + path;
+        Close();
+        return false;
+    }
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        error = "Cannot open " + path;
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0)
+    {
+        error = "Cannot read " + path;
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file.
+    if (view == MAP_FAILED)
+    {
+        error = "Cannot map " + path;
+        return false;
+    }
+    mapping = view;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(status.st_size);
+#endif
+    if (Validate() == false)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool CoreBinaryReader::Open(const void* memory, size_t memorySize)
+{
+    Close();
+    data = static_cast<const unsigned char*>(memory);
+    size = memorySize;
+    if (Validate() == false)
+    {
+        data = nullptr;
+        size = 0;
+        return false;
+    }
+    return true;
+}
+
+bool CoreBinaryReader::Validate()
+{
+    // Everything the loaders index is checked here, once, so they can read without checks.
+    if (size < sizeof(BinaryHeader))
+    {
+        error = "The file is too short.";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(BinaryHeader));
+    if (std::memcmp(header.magic, BinaryHeader().magic, sizeof(header.magic)) != 0)
+    {
+        error = "Not a binary project file.";
+        return false;
+    }
+    if (header.version != BinaryHeader().version || header.headerSize != sizeof(BinaryHeader))
+    {
+        error = "Unsupported binary version " + std::to_string(header.version) + ".";
+        return false;
+    }
+    for (int i = 0; i < static_cast<int>(BinaryTable::Num); i++)
+    {
+        const uint64_t offset = header.tableOffset[i];
+        const uint64_t count = header.tableCount[i];
+        if (offset > size || count > (size - offset) / recordSize[i])
+        {
+            error = "A table is out of the file.";
+            return false;
+        }
+    }
+    const size_t nodeNum = GetCount(BinaryTable::Nodes);
+    for (size_t i = 0; i < nodeNum; i++)
+    {
+        const BinaryNode node = GetNode(i);
+        if (uint64_t(node.firstInput) + node.inputNum > GetCount(BinaryTable::Inputs) ||
+            uint64_t(node.firstOutput) + node.outputNum > GetCount(BinaryTable::Outputs) ||
+            uint64_t(node.firstParam) + node.paramNum > GetCount(BinaryTable::Params))
+        {
+            error = "A node refers to missing ports or parameters.";
+            return false;
+        }
+    }
+    for (size_t i = 0; i < GetCount(BinaryTable::Links); i++)
+    {
+        const BinaryLink link = GetLink(i);
+        if (link.inputNode >= nodeNum || link.outputNode >= nodeNum)
+        {
+            error = "A link refers to a missing node.";
+            return false;
+        }
+    }
+    for (size_t i = 0; i < GetCount(BinaryTable::ExeOrder); i++)
+    {
+        if (GetExe(i) >= nodeNum)
+        {
+            error = "The execution order refers to a missing node.";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string CoreBinaryReader::GetString(const BinaryString& str) const
+{
+    const uint64_t length = GetCount(BinaryTable::Strings);
+    if (uint64_t(str.offset) + str.size > length)
+    {
+        return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(data + header.tableOffset[static_cast<int>(BinaryTable::Strings)] + str.offset), str.size);
+}
+
+bool CoreBinaryReader::IsBinary(const std::string& path)
+{
+    char magic[sizeof(BinaryHeader().magic)] = {};
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr)
+    {
+        return false;
+    }
+    const size_t n = std::fread(magic, 1, sizeof(magic), f);
+    std::fclose(f);
+    return n == sizeof(magic) && std::memcmp(magic, BinaryHeader().magic, sizeof(magic)) == 0;
+}
+
+pugi::xml_document CoreBinaryReader::CreateDoc() const
+{
+    pugi::xml_document doc;
+    auto declarationNode = doc.append_child(pugi::node_declaration);
+    declarationNode.append_attribute("version") = "1.0";
+    declarationNode.append_attribute("encoding") = "ISO-8859-1";
+    declarationNode.append_attribute("standalone") = "yes";
+    auto root = doc.append_child("core-nodes");
+    root.append_attribute("version").set_value(projectVersion.c_str());
+
+    auto sim = root.append_child("simulation");
+    sim.append_attribute("solver").set_value(header.solver);
+    sim.append_attribute("sampleTime").set_value(header.sampleTime);
+    sim.append_attribute("stopTime").set_value(header.stopTime);
+    sim.append_attribute("relTol").set_value(header.relTol);
+    sim.append_attribute("absTol").set_value(header.absTol);
+    sim.append_attribute("speed").set_value(GetString(header.speed).c_str());
+    sim.append_attribute("timeScale").set_value(header.timeScale);
+
+    auto diagram = root.append_child("diagram");
+    diagram.append_attribute("scale") = header.scale;
+    diagram.append_attribute("scrollX") = header.scroll.x;
+    diagram.append_attribute("scrollY") = header.scroll.y;
+    diagram.append_attribute("hNode") = GetString(header.hNode).c_str();
+    std::vector<std::string> names(GetCount(BinaryTable::Nodes));
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        names[i] = GetString(GetNode(i).name);
+    }
+    auto exeList = diagram.append_child("exeList");
+    for (size_t i = 0; i < GetCount(BinaryTable::ExeOrder); i++)
+    {
+        exeList.append_child("node").append_attribute("name") = names[GetExe(i)].c_str();
+    }
+    auto nodeList = diagram.append_child("nodeList");
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        // Authored state only, as CoreNode::Save writes it.
+        const BinaryNode record = GetNode(i);
+        auto node = nodeList.append_child("node");
+        node.append_attribute("name") = names[i].c_str();
+        node.append_attribute("libName") = GetString(record.libName).c_str();
+        node.append_attribute("x") = record.rectNode.xMin;
+        node.append_attribute("y") = record.rectNode.yMin;
+        node.append_attribute("flags") = record.flagSet & ~NodeFlag::Hovered;
+        node.append_attribute("inverted") = record.portInverted != 0;
+        for (uint32_t j = 0; j < record.paramNum; j++)
+        {
+            const BinaryParam param = GetParam(record.firstParam + j);
+            auto element = node.append_child("param");
+            element.append_attribute("name") = GetString(param.name).c_str();
+            element.append_attribute("value") = param.value;
+        }
+    }
+    auto linkList = diagram.append_child("linkList");
+    for (size_t i = 0; i < GetCount(BinaryTable::Links); i++)
+    {
+        const BinaryLink record = GetLink(i);
+        auto link = linkList.append_child("link");
+        link.append_attribute("inputNode") = names[record.inputNode].c_str();
+        link.append_attribute("inputPort") = record.inputPort;
+        link.append_attribute("outputNode") = names[record.outputNode].c_str();
+        link.append_attribute("outputPort") = record.outputPort;
+    }
+    return doc;
+}
\ No newline at end of file
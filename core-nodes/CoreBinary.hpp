@@ -0,0 +1,241 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Binary                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREBINARY_HPP
+#define COREBINARY_HPP
+
+#include "CoreSerialize.hpp"
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// Binary project file. A header, tables of fixed-size records and a string table. The file is mapped
+// and each record is copied out where it lies, nothing is parsed. It holds the fields of the XML
+// format, a project goes from one format to the other and back without loss.
+// Records are stored in the byte order of the machine, little-endian on every supported platform.
+
+struct BinaryString                         // Bytes in the string table, not terminated.
+{
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+struct BinaryVec2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct BinaryRect
+{
+    float xMin = 0.0f;
+    float yMin = 0.0f;
+    float xMax = 0.0f;
+    float yMax = 0.0f;
+};
+
+struct BinaryColor
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 0.0f;
+};
+
+inline BinaryVec2 ToBinary(ImVec2 v) { return BinaryVec2{ v.x, v.y }; }
+inline BinaryRect ToBinary(const ImRect& r) { return BinaryRect{ r.Min.x, r.Min.y, r.Max.x, r.Max.y }; }
+inline BinaryColor ToBinary(const ImColor& c) { return BinaryColor{ c.Value.x, c.Value.y, c.Value.z, c.Value.w }; }
+inline ImVec2 FromBinary(const BinaryVec2& v) { return ImVec2(v.x, v.y); }
+inline ImRect FromBinary(const BinaryRect& r) { return ImRect(r.xMin, r.yMin, r.xMax, r.yMax); }
+inline ImColor FromBinary(const BinaryColor& c) { return ImColor(c.x, c.y, c.z, c.w); }
+
+struct BinaryPort                           // Input or output.
+{
+    BinaryString name;
+    BinaryVec2 position;
+    float ref = 0.0f;
+    BinaryRect rectName;
+    BinaryRect rectPin;
+    BinaryRect rectPort;
+    int32_t type = 0;
+    int32_t dataType = 0;
+    int32_t order = 0;
+    int32_t flagSet = 0;
+    int32_t inverted = 0;
+    int32_t linkDir = 0;                    // Inputs only.
+    int32_t linkSepX = 0;
+    int32_t linkSepY = 0;
+    int32_t targetLinkDir = 0;
+    int32_t targetLinkSep = 0;
+    int32_t linkNum = 0;                    // Outputs only.
+};
+
+struct BinaryParam
+{
+    BinaryString name;
+    double value = 0.0;
+};
+
+struct BinaryNode
+{
+    BinaryString name;
+    BinaryString libName;
+    int32_t type = 0;
+    int32_t flagSet = 0;
+    BinaryColor colorNode;
+    BinaryColor colorHead;
+    BinaryColor colorLine;
+    BinaryColor colorBody;
+    BinaryRect rectNode;
+    BinaryRect rectNodeTitle;
+    BinaryRect rectName;
+    float titleHeight = 0.0f;
+    float bodyHeight = 0.0f;
+    BinaryVec2 leftPortPos;
+    BinaryVec2 rightPortPos;
+    int32_t portInverted = 0;
+    float inputsWidth = 0.0f;
+    float inputsHeight = 0.0f;
+    float outputsWidth = 0.0f;
+    float outputsHeight = 0.0f;
+    uint32_t firstInput = 0;                // Ranges in the port and parameter tables.
+    uint32_t inputNum = 0;
+    uint32_t firstOutput = 0;
+    uint32_t outputNum = 0;
+    uint32_t firstParam = 0;
+    uint32_t paramNum = 0;
+};
+
+struct BinaryLink
+{
+    uint32_t inputNode = 0;                 // Positions in the node table.
+    uint32_t outputNode = 0;
+    int32_t inputPort = 0;
+    int32_t outputPort = 0;
+    int32_t type = 0;
+    BinaryColor color;
+    float thickness = 0.0f;
+    float xSepIn = 0.0f;
+    float xSepOut = 0.0f;
+    float ykSep = 0.0f;
+};
+
+enum class BinaryTable
+{
+    Nodes = 0,
+    Inputs,
+    Outputs,
+    Params,
+    Links,
+    ExeOrder,                               // Positions in the node table, uint32_t.
+    Strings,                                // Bytes.
+    Num
+};
+
+struct BinaryHeader
+{
+    char magic[8] = { 'D', 'X', 'D', 'T', 'B', 'I', 'N', '\0' };
+    uint32_t version = 1;
+    uint32_t headerSize = sizeof(BinaryHeader);
+    uint64_t tableOffset[static_cast<int>(BinaryTable::Num)] = {};
+    uint64_t tableCount[static_cast<int>(BinaryTable::Num)] = {};
+    BinaryString docVersion;                // <core-nodes version>
+
+    // <simulation>
+    int32_t solver = 0;
+    uint32_t reserved = 0;
+    double sampleTime = 0.0;
+    double stopTime = 0.0;
+    double relTol = 0.0;
+    double absTol = 0.0;
+    double timeScale = 0.0;
+    BinaryString speed;
+
+    // <diagram>
+    float scale = 1.0f;
+    BinaryVec2 scroll;
+    BinaryString hNode;
+};
+
+class CoreBinaryWriter
+{
+private:
+    BinaryHeader header;
+    std::vector<BinaryNode> nodes;
+    std::vector<BinaryPort> inputs;
+    std::vector<BinaryPort> outputs;
+    std::vector<BinaryParam> params;
+    std::vector<BinaryLink> links;
+    std::vector<uint32_t> exeOrder;
+    std::string strings;
+    std::unordered_map<std::string, BinaryString> stringIndex; // Port and library names repeat a lot.
+
+public:
+    CoreBinaryWriter() = default;
+    virtual ~CoreBinaryWriter() = default;
+    BinaryHeader& GetHeader() { return header; }
+    BinaryString AddString(const std::string& str);
+    void AddNode(const BinaryNode& record) { nodes.push_back(record); }
+    void AddInput(const BinaryPort& record) { inputs.push_back(record); }
+    void AddOutput(const BinaryPort& record) { outputs.push_back(record); }
+    void AddParam(const BinaryParam& record) { params.push_back(record); }
+    void AddLink(const BinaryLink& record) { links.push_back(record); }
+    void AddExe(uint32_t node) { exeOrder.push_back(node); }
+    uint32_t GetInputNum() const { return static_cast<uint32_t>(inputs.size()); }
+    uint32_t GetOutputNum() const { return static_cast<uint32_t>(outputs.size()); }
+    uint32_t GetParamNum() const { return static_cast<uint32_t>(params.size()); }
+    std::string GetData();                  // Contents of the file.
+};
+
+class CoreBinaryReader
+{
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    BinaryHeader header;
+    std::string error;
+    void* mapping = nullptr;                // Kept for unmapping.
+    void* file = nullptr;
+    bool Validate();
+    void Close();
+
+public:
+    CoreBinaryReader() = default;
+    CoreBinaryReader(const CoreBinaryReader&) = delete;
+    CoreBinaryReader& operator=(const CoreBinaryReader&) = delete;
+    virtual ~CoreBinaryReader();
+    bool Open(const std::string& path);     // Maps the file.
+    bool Open(const void* memory, size_t memorySize); // The memory must outlive the reader.
+    const std::string& GetError() const { return error; }
+    const BinaryHeader& GetHeader() const { return header; }
+    size_t GetCount(BinaryTable table) const { return static_cast<size_t>(header.tableCount[static_cast<int>(table)]); }
+    std::string GetString(const BinaryString& str) const;
+
+    // Record i of a table, the index is checked by Validate for the ranges stored in the file.
+    template<typename T>
+    T Get(BinaryTable table, size_t i) const
+    {
+        T record;
+        std::memcpy(&record, data + header.tableOffset[static_cast<int>(table)] + i * sizeof(T), sizeof(T));
+        return record;
+    }
+    BinaryNode GetNode(size_t i) const { return Get<BinaryNode>(BinaryTable::Nodes, i); }
+    BinaryPort GetInput(size_t i) const { return Get<BinaryPort>(BinaryTable::Inputs, i); }
+    BinaryPort GetOutput(size_t i) const { return Get<BinaryPort>(BinaryTable::Outputs, i); }
+    BinaryParam GetParam(size_t i) const { return Get<BinaryParam>(BinaryTable::Params, i); }
+    BinaryLink GetLink(size_t i) const { return Get<BinaryLink>(BinaryTable::Links, i); }
+    uint32_t GetExe(size_t i) const { return Get<uint32_t>(BinaryTable::ExeOrder, i); }
+
+    pugi::xml_document CreateDoc() const;   // The project in the XML format.
+
+    static bool IsBinary(const std::string& path); // Checks the magic bytes.
+};
+
+#endif /* COREBINARY_HPP */
\ No newline at end of file
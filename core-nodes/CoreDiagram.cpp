@@ -9,16 +9,10 @@
 
 #include "CoreDiagram.hpp"
 
-CoreDiagram::~CoreDiagram()
-{
-    for (const auto& node : coreNodeVec)
-    {
-        delete node;
-    }
-}
-
 void CoreDiagram::Update()
 {
+    const long long heapAllocStart = GetHeapAllocNum();
+    frameArena.Reset();
     UpdateCanvasRect();
     UpdateCanvasScrollZoom();
     UpdateCanvasGrid(ImGui::GetWindowDrawList());
@@ -26,100 +20,75 @@ void CoreDiagram::Update()
     Actions();
     DrawCanvasElements();
     PopupMenu();
+    heapAllocNum = GetHeapAllocNum() - heapAllocStart;
 }
 
-void CoreDiagram::Save(pugi::xml_node& xmlNode) const
+void CoreDiagram::Load(const pugi::xml_node& xmlNode)
 {
-    auto node = xmlNode.append_child("diagram");
-    SaveFloat(node, "scale", scale);
-    SaveImVec2(node, "scroll", scroll);
-    highlightedNode != nullptr ? SaveString(node, "hNode", highlightedNode->GetName()) : SaveString(node, "hNode", "");
-    auto exeList = node.append_child("exeList");
-    for (const auto& element : exeOrder)
+    auto node = xmlNode.child("diagram");
+    const bool v1 = IsProjectV1(xmlNode);
+    state = State::Default;
+    if (v1 == true)
     {
-        exeList.append_child("node").append_attribute("name") = element->GetName().c_str();
+        scale = LoadFloat(node, "scale");
+        scroll = LoadImVec2(node, "scroll");
     }
-    auto nodeList = node.append_child("nodeList");
-    for (const auto& element : coreNodeVec)
+    else
     {
-        element->Save(nodeList);
+        scale = node.attribute("scale").as_float(1.0f);
+        scroll = ImVec2(node.attribute("scrollX").as_float(), node.attribute("scrollY").as_float());
     }
-    auto linkList = node.append_child("linkList");
-    for (const auto& element : linkVec)
+    highlightedNode = nullptr;
+    hovNode = nullptr;
+    iNode = nullptr;
+    iNodeInput = nullptr;
+    iNodeOutput = nullptr;
+    visibleNodes.clear();
+    drawCache.Clear();
+    rectCanvas = ImRect();
+    rectSelecting = ImRect();
+    inputFreeLink = ImVec2();
+    outputFreeLink = ImVec2();
+    if (v1 == true)
+    {
+        LoadGraphV1(node);
+        highlightedNode = FindNode(LoadString(node, "hNode"));
+    }
+    else
     {
-        element.Save(linkList);
+        LoadGraph(node);
+        highlightedNode = FindNode(node.attribute("hNode").as_string());
     }
 }
 
-void CoreDiagram::Load(const pugi::xml_node& xmlNode)
+void CoreDiagram::Save(CoreBinaryWriter& writer) const
 {
-    auto node = xmlNode.child("diagram");
+    auto& header = writer.GetHeader();
+    header.scale = scale;
+    header.scroll = ToBinary(scroll);
+    header.hNode = writer.AddString(highlightedNode != nullptr ? highlightedNode->GetName() : "");
+    SaveGraph(writer);
+}
+
+void CoreDiagram::Load(const CoreBinaryReader& reader)
+{
+    const auto& header = reader.GetHeader();
     state = State::Default;
-    scale = LoadFloat(node, "scale");
-    scroll = LoadImVec2(node, "scroll");
+    scale = header.scale;
+    scroll = FromBinary(header.scroll);
     highlightedNode = nullptr;
     hovNode = nullptr;
     iNode = nullptr;
     iNodeInput = nullptr;
     iNodeOutput = nullptr;
+    visibleNodes.clear();
+    drawCache.Clear();
     rectCanvas = ImRect();
     rectSelecting = ImRect();
     inputFreeLink = ImVec2();
     outputFreeLink = ImVec2();
-    for (const auto& element : node.child("nodeList").children("node"))
-    {
-        // Add node without building.
-        coreNodeVec.push_back(coreLib.GetNode(LoadString(element, "libName"), LoadString(element, "name")));
-        coreNodeVec.back()->Load(element);
-    }
-    auto hName = LoadString(node, "hNode");
-    for (const auto element : coreNodeVec)
-    {
-        if (element->GetName() == hName)
-        {
-            highlightedNode = element;
-        }
-    }
-    for (const auto& element : node.child("linkList").children("link"))
-    {
-        linkVec.emplace_back();
-        linkVec.back().Load(element);
-
-        // Match pointers
-        auto inputNodeName = LoadString(element, "inputNode");
-        auto outputNodeName = LoadString(element, "outputNode");
-        auto inputPortOrder = LoadInt(element, "inputPort");
-        auto outputPortOrder = LoadInt(element, "outputPort");
-        for (auto coreNode : coreNodeVec)
-        {
-            auto coreName = coreNode->GetName();
-            if (coreName == inputNodeName)
-            {
-                linkVec.back().inputNode = coreNode;
-                linkVec.back().inputPort = &(coreNode->GetInputVec().at(inputPortOrder));
-            }
-            if (coreName == outputNodeName)
-            {
-                linkVec.back().outputNode = coreNode;
-                linkVec.back().outputPort = &(coreNode->GetOutputVec().at(outputPortOrder));
-            }
-        }
-        for (auto& link : linkVec)
-        {
-            link.inputPort->SetTargetNode(link.outputNode);
-            link.inputPort->SetTargetNodeOutput(link.outputPort);
-        }
-    }
-    for (const auto& element : node.child("exeList").children("node"))
-    {
-        for (const auto nodeElement : coreNodeVec)
-        {
-            if (nodeElement->GetName() == element.attribute("name").as_string())
-            {
-                exeOrder.push_back(nodeElement);
-            }
-        }
-    }
+    LoadGraph(reader);
+    highlightedNode = FindNode(reader.GetString(header.hNode));
 }
 
 void CoreDiagram::DrawExplorer()
@@ -135,10 +104,11 @@ void CoreDiagram::DrawExplorer()
             int iNext = i + (ImGui::GetMouseDragDelta(0).y < 0.0f ? -1 : 1);
             if (iNext >= 0 && iNext < exeOrder.size())
             {
-                exeOrder.at(i) = exeOrder.at(iNext);
-                exeOrder.at(iNext) = item;
+                if (SwapExeOrder(i, iNext) == true)
+                {
+                    RecordOrder(i, iNext);
+                }
                 ImGui::ResetMouseDragDelta();
-                modifFlag = true;
             }
         }
     }
@@ -148,16 +118,56 @@ void CoreDiagram::DrawProperties()
 {
     if (highlightedNode != nullptr)
     {
-        highlightedNode->DrawProperties(coreNodeVec);
+        ImGui::Text(highlightedNode->GetLibName().c_str());
+        ImGui::Separator();
+        ImGui::Text(highlightedNode->GetDescription().c_str());
+        ImGui::NewLine();
+        ImGui::Text("Parameters");
+        ImGui::Separator();
+        EditName(highlightedNode);
+        const auto params = highlightedNode->GetParams();
+        for (int i = 0; i < params.size(); i++)
+        {
+            const double before = params[i]->Get();
+            bool entered = false;
+            params[i]->Draw(entered);
+            if (entered == true && params[i]->Get() != before)
+            {
+                RecordParam(highlightedNode, i, before);
+            }
+        }
     }
-    for (const auto& element : coreNodeVec)
+}
+
+void CoreDiagram::EditName(CoreNode* node)
+{
+    if (editingName == false)
     {
-        if (element->GetModifFlag() == true)
+        nameEdited = node->GetName();
+    }
+    ImGui::AlignTextToFramePadding();
+    ImGui::Text("name");
+    ImGui::SameLine(100.0f);
+    ImGui::SetNextItemWidth(140.0f);
+    ImGui::PushStyleColor(ImGuiCol_Text, editingName ? ImVec4(0.992f, 0.914f, 0.169f, 1.0f) : ImGuiStyle().Colors[ImGuiCol_Text]);
+    ImGui::PushID(node);
+    const bool entered = ImGui::InputText("##name", &nameEdited, ImGuiInputTextFlags_EnterReturnsTrue); // ImGuiInputTextFlags_CharsNoBlank
+    ImGui::PopID();
+    if (entered == true)
+    {
+        if (FindNode(nameEdited) == nullptr)
+        {
+            RecordRename(node->GetName(), nameEdited);
+            RenameNode(node, nameEdited);
+        }
+        else if (nameEdited != node->GetName())
         {
-            modifFlag = true;
-            element->ResetModifFlag();
+            Notifier::Add(Notif(Notif::Type::ERROR, "The name \"" + nameEdited + "\"" + " already exists!", "Enter a unique name.", 5.0f));
+            nameEdited = node->GetName();
         }
     }
+    editingName = ImGui::IsItemActive() ? true : false;
+    ImGui::PopStyleColor(1);
 }
 
 void CoreDiagram::Actions()
@@ -269,31 +279,15 @@ void CoreDiagram::MouseLeftButtonDoubleClick()
         titleArea.Translate(offset);
         if (titleArea.Contains(mousePos))
         {
-            ImRect rNode = hovNode->GetRectNode();
-            if (hovNode->GetFlagSet().HasFlag(NodeFlag::Collapsed))
-            {
-                hovNode->GetFlagSet().UnsetFlag(NodeFlag::Collapsed);
-                rNode.Max.y += hovNode->GetBodyHeight();
-                hovNode->SetRectNode(rNode);
-                //iNode->Translate(ImVec2(0.0f, iNode->GetBodyHeight() * -0.5f));
-            }
-            else
-            {
-                hovNode->GetFlagSet().SetFlag(NodeFlag::Collapsed);
-                rNode.Max.y -= hovNode->GetBodyHeight();
-                hovNode->SetRectNode(rNode);
-                //iNode->Translate(ImVec2(0.0f, iNode->GetBodyHeight() * 0.5f));
-            }
-            modifFlag = true;
+            ToggleCollapse(hovNode);
+            RecordToggle(hovNode, true);
         }
     }
     else if (state == State::HoveringInput) // Break connection
     {
         if (iNodeInput->GetTargetNode())
         {
-            iNodeInput->BreakLink();
-            EraseLink(iNodeInput);
-            modifFlag = true;
+            Disconnect(hovNode, iNodeInput);
             state = State::DragingInput; // To be able to drag input after breaking.
         }
     }
@@ -301,17 +295,10 @@ void CoreDiagram::MouseLeftButtonDoubleClick()
     {
         if (iNodeOutput->GetLinkNum() != 0)
         {
-            for (const auto& node : coreNodeVec)
+            const auto consumers = GetConsumers(iNodeOutput); // Copy, erasing the links updates the list.
+            for (const auto& consumer : consumers)
             {
-                for (auto& input : node->GetInputVec())
-                {
-                    if (input.GetTargetNodeOutput() == iNodeOutput)
-                    {
-                        input.BreakLink();
-                        EraseLink(&input);
-                        modifFlag = true;
-                    }
-                }
+                Disconnect(consumer.node, consumer.input);
             }
         }
     }
@@ -329,7 +316,7 @@ void CoreDiagram::MouseRightButtonDoubleClick()
         if (titleArea.Contains(mousePos) && hovNode->GetFlagSet().HasFlag(NodeFlag::Collapsed) == false)
         {
             hovNode->InvertPort();
-            modifFlag = true;
+            RecordToggle(hovNode, false);
         }
     }
     else if (state == State::HoveringNode)
@@ -364,7 +351,6 @@ void CoreDiagram::MouseLeftButtonSingleClick()
         {
             highlightedNode->GetFlagSet().UnsetFlag(NodeFlag::Highlighted);
             highlightedNode = nullptr;
-            modifFlag = true;
         }
     }
     else if (state == State::HoveringNode)
@@ -388,6 +374,7 @@ void CoreDiagram::MouseLeftButtonSingleClick()
             SortNodeOrder();
         }
         state = State::Draging; // SetState:Draging
+        dragOrigin = iNode->GetRectNode().Min;
         distFromClickToCenter = (mousePos - rectCanvas.GetTL() - scroll) / scale - iNode->GetRectNode().GetCenter();
     }
     else if (state == State::HoveringInput)
@@ -399,6 +386,7 @@ void CoreDiagram::MouseLeftButtonSingleClick()
         else
         {
             state = State::Draging;
+            dragOrigin = iNode->GetRectNode().Min;
 
             const ImGuiIO& io = ImGui::GetIO();
             if (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)
@@ -508,21 +496,21 @@ void CoreDiagram::MouseLeftButtonRelease()
         if (coreLib.IsLeafClicked() == true) // If a leaf clicked then released on the canvas, create the leaf.
         {
             auto leafName = coreLib.GetSelectedLeaf();
-            auto newNode = coreLib.GetNode(leafName, CreateUniqueName(leafName));
+            auto newNode = coreLib.GetNode(nodePool, leafName, CreateUniqueName(leafName));
             if (newNode != nullptr)
             {
                 newNode->Build();
                 ImVec2 pos = (mousePos - scroll - position) / scale;
                 newNode->Translate(pos - newNode->GetRectNode().GetCenter());
                 newNode->GetFlagSet().SetFlag(NodeFlag::Visible | NodeFlag::Hovered | NodeFlag::Highlighted);
-                coreNodeVec.push_back(newNode);
-                exeOrder.push_back(newNode);
+                AddNode(newNode);
+                visibleNodes.push_back(newNode);
                 if (highlightedNode != nullptr)
                 {
                     highlightedNode->GetFlagSet().UnsetFlag(NodeFlag::Highlighted);
                 }
                 highlightedNode = newNode;
-                modifFlag = true;
+                RecordAdd(newNode);
                 coreLib.SetLeafClickedFalse();
             }
             else
@@ -543,7 +531,7 @@ void CoreDiagram::MouseLeftButtonRelease()
         state = State::HoveringNode; //SetState:HoveringNode
         if (mNodeDrag == true)
         {
-            modifFlag = true;
+            RecordMove();
             mNodeDrag = false;
         }
     }
@@ -553,8 +541,7 @@ void CoreDiagram::MouseLeftButtonRelease()
         {
             if (iNodeInput->GetTargetNodeOutput()) // If input is already connected to another output.
             {
-                iNodeInput->BreakLink();
-                EraseLink(iNodeInput);
+                Disconnect(state == State::DragingInput ? iNode : hovNode, iNodeInput);
             }
 
             Link link;
@@ -562,21 +549,15 @@ void CoreDiagram::MouseLeftButtonRelease()
             {
                 link.inputNode = iNode;
                 link.outputNode = hovNode;
-                iNodeInput->SetTargetNode(hovNode);
             }
             if (state == State::DragingOutput)
             {
                 link.inputNode = hovNode;
                 link.outputNode = iNode;
-                iNodeInput->SetTargetNode(iNode);
             }
-            iNodeInput->SetTargetNodeOutput(iNodeOutput);
-            iNodeOutput->IncreaseLinkNum();
-
             link.inputPort = iNodeInput;
             link.outputPort = iNodeOutput;
-            linkVec.push_back(link);
-            modifFlag = true;
+            Connect(link);
         }
 
         inputFreeLink = ImVec2();
@@ -612,90 +593,99 @@ void CoreDiagram::MouseRightButtonRelease()
 
 void CoreDiagram::KeyboardPressDelete()
 {
-    std::vector<CoreNode*> unselectedNodes;
     std::vector<CoreNode*> selectedNodes;
-    unselectedNodes.reserve(coreNodeVec.size());
-    selectedNodes.reserve(coreNodeVec.size());
     for (const auto& node : coreNodeVec)
     {
         if (node->GetFlagSet().HasFlag(NodeFlag::Selected))
         {
-            // Delete all input connections.
-            for (auto& input : node->GetInputVec())
-            {
-                if (input.GetTargetNode() != nullptr)
-                {
-                    input.BreakLink();
-                    EraseLink(&input);
-                }
-            }
-            // Delete all connections that are connected with outputs.
-            for (const auto& otherNode : coreNodeVec)
-            {
-                for (auto& input : otherNode->GetInputVec())
-                {
-                    if (input.GetTargetNode() != nullptr && input.GetTargetNode() == node)
-                    {
-                        input.BreakLink();
-                        EraseLink(&input);
-                    }
-                }
-            }
-            // Check all output connections.
-            for (const auto& output : node->GetOutputVec())
-            {
-                IM_ASSERT(output.GetLinkNum() == 0);
-            }
-
-            if (node == highlightedNode)
-            {
-                highlightedNode = nullptr;
-            }
-            if (node == hovNode)
-            {
-                hovNode = nullptr;
-            }
-            if (node == iNode)
-            {
-                iNode = nullptr;
-            }
             selectedNodes.push_back(node);
-            modifFlag = true;
-        }
-        else
-        {
-            unselectedNodes.push_back(node);
         }
     }
-
-    // Delete selected nodes
-    for (const auto& node : selectedNodes)
+    if (selectedNodes.empty() == true)
     {
-        auto it = std::find(exeOrder.begin(), exeOrder.end(), node);
-        exeOrder.erase(it);
-        delete node;
+        return;
     }
-    coreNodeVec = unselectedNodes;
+    DeleteNodes(selectedNodes);
 }
 
 void CoreDiagram::DrawCanvasElements()
 {
     SetLinkProperties();
+    drawCache.BeginFrame(scale);
     DrawLinks();
     DrawNodes();
+    drawCache.EndFrame();
     DrawFreeLink();
     DrawSelecting();
     PrintInfo();
 }
 
-void CoreDiagram::DrawNodes() const
+NodeDetail CoreDiagram::GetDetail() const
+{
+    if (scale < scaleFlat)
+    {
+        return NodeDetail::Flat;
+    }
+    if (scale < scaleSimple)
+    {
+        return NodeDetail::Simple;
+    }
+    return NodeDetail::Full;
+}
+
+void CoreDiagram::DrawNodes()
 {
     ImDrawList* drawList = ImGui::GetWindowDrawList();
-    ImGui::SetWindowFontScale(scale);
     const ImVec2 offset = position + scroll;
-    for (const auto& node : coreNodeVec)
+    const NodeDetail detail = GetDetail();
+    if (detail == NodeDetail::Flat)
+    {
+        // Nodes within a cell share one quad, so the vertex count follows the canvas size instead of the model size.
+        const int cellsX = static_cast<int>(rectCanvas.GetWidth() / lodCell) + 1;
+        const int cellsY = static_cast<int>(rectCanvas.GetHeight() / lodCell) + 1;
+        lodCoverage.assign(static_cast<size_t>(cellsX) * cellsY, 0);
+        for (const auto& node : visibleNodes)
+        {
+            const ImRect rect(node->GetRectNode().Min * scale + offset, node->GetRectNode().Max * scale + offset);
+            if (rect.GetWidth() <= lodCell && rect.GetHeight() <= lodCell)
+            {
+                const ImVec2 center = rect.GetCenter() - rectCanvas.Min;
+                const int x = ImClamp(static_cast<int>(center.x / lodCell), 0, cellsX - 1);
+                const int y = ImClamp(static_cast<int>(center.y / lodCell), 0, cellsY - 1);
+                unsigned char& covered = lodCoverage[static_cast<size_t>(y) * cellsX + x];
+                if (covered == 1)
+                {
+                    continue;
+                }
+                covered = 1;
+            }
+            node->Draw(drawList, offset, scale, detail);
+        }
+        return;
+    }
+    ImGui::SetWindowFontScale(scale);
+    const bool portDragging = state == State::DragingInput || state == State::DragingOutput;
+    for (const auto& node : visibleNodes) // Only these can be visible.
     {
-        node->Draw(drawList, offset, scale);
+        if (node->GetFlagSet().HasFlag(NodeFlag::Visible) == false)
+        {
+            continue;
+        }
+        // ImGui drops the clipped text, so nodes on the canvas edge and the dragged port names are not cached.
+        const ImRect rect(node->GetRectNode().Min * scale + offset, node->GetRectNode().Max * scale + offset);
+        if (rectCanvas.Contains(rect) == false || (portDragging == true && node == iNode))
+        {
+            node->Draw(drawList, offset, scale, detail);
+            continue;
+        }
+        const unsigned long long signature = node->GetDrawSignature(detail);
+        if (drawCache.Replay(drawList, node, signature, offset) == true)
+        {
+            continue;
+        }
+        drawCache.BeginRecord(drawList, offset);
+        node->Draw(drawList, offset, scale, detail);
+        drawCache.EndRecord(drawList, node, signature);
     }
     ImGui::SetWindowFontScale(1.0f);
 }
@@ -725,21 +715,29 @@ void CoreDiagram::PrintInfo()
     ImGui::Text("Scale: %.2f", scale);
 
     ImGui::NewLine();
-    int numberOfVisibleNodes = 0;
-    for (const auto& node : coreNodeVec)
+    const ImVec2 offset = position + scroll;
+    const int numberOfVisibleNodes = boundsTable.CountOverlapping(ImRect((position - offset) / scale, (position + size - offset) / scale));
+    ImGui::Text("Visible Nodes #: %d", numberOfVisibleNodes);
+    ImGui::Text("Heap Allocations: %lld", heapAllocNum);
+    ImGui::Text("Frame Arena: %zu / %zu", frameArena.GetPeak(), frameArena.GetCapacity());
+    ImGui::Text("Draw Cache: %d replayed, %d recorded", drawCache.GetReplayedNum(), drawCache.GetRecordedNum());
+    ImGui::Text("Undo History: %zu steps, %zu bytes", journal.GetStepNum(), journal.GetMemory());
+
+    // Only 8 bits, formatted on the stack.
+    auto bits = [](int flags, char* text)
     {
-        if (node->GetFlagSet().HasFlag(NodeFlag::Visible))
+        for (int i = 0; i < 8; i++)
         {
-            numberOfVisibleNodes += 1;
+            text[i] = (flags >> (7 - i)) & 1 ? '1' : '0';
         }
-    }
-    ImGui::Text("Visible Nodes #: %d", numberOfVisibleNodes);
-
-    // Only 8 bits.
+        text[8] = '\0';
+        return text;
+    };
+    char text[9];
     ImGui::NewLine();
-    ImGui::Text("FlagSet Node: %s", iNode ? iNode->GetFlagSet().Get().substr(8 * sizeof(unsigned int) - 8, 8).c_str() : nullptr);
-    ImGui::Text("FlagSet Input: %s", iNodeInput ? iNodeInput->GetFlagSet().Get().substr(8 * sizeof(unsigned int) - 8, 8).c_str() : nullptr);
-    ImGui::Text("FlagSet Output: %s", iNodeOutput ? iNodeOutput->GetFlagSet().Get().substr(8 * sizeof(unsigned int) - 8, 8).c_str() : nullptr);
+    ImGui::Text("FlagSet Node: %s", iNode ? bits(iNode->GetFlagSet().GetInt(), text) : nullptr);
+    ImGui::Text("FlagSet Input: %s", iNodeInput ? bits(iNodeInput->GetFlagSet().GetInt(), text) : nullptr);
+    ImGui::Text("FlagSet Output: %s", iNodeOutput ? bits(iNodeOutput->GetFlagSet().GetInt(), text) : nullptr);
 
     ImGui::NewLine();
     switch (state)
@@ -785,7 +783,6 @@ void CoreDiagram::PrintInfo()
 
     ImGui::Text("Total Links #: %d", linkVec.size());
     int numberOfVisibleLinks = 0;
-    const ImVec2 offset = position + scroll;
     for (const auto& link : linkVec)
     {
         ImVec2 pInput = link.inputPort->GetPosition() * scale + offset;
@@ -856,8 +853,8 @@ void CoreDiagram::UpdateCanvasScrollZoom()
 void CoreDiagram::UpdateCanvasGrid(ImDrawList* drawList) const
 {
     const float grid = 32.0f * scale;
-    float x = std::fmodf(scroll.x, grid);
-    float y = std::fmodf(scroll.y, grid);
+    float x = std::fmod(scroll.x, grid);
+    float y = std::fmod(scroll.y, grid);
     auto markX = static_cast<int>(scroll.x / grid);
     auto markY = static_cast<int>(scroll.y / grid);
     while (x < size.x)
@@ -884,16 +881,7 @@ void CoreDiagram::FitToWindow()
     }
 
     // Rectangle of all nodes.
-    ImVec2 min = coreNodeVec.at(0)->GetRectNode().GetTL();
-    ImVec2 max = coreNodeVec.at(0)->GetRectNode().GetBR();
-    for (const auto& element : coreNodeVec)
-    {
-        if (auto xTL = element->GetRectNode().GetTL().x; min.x > xTL) { min.x = xTL; }
-        if (auto yTL = element->GetRectNode().GetTL().y; min.y > yTL) { min.y = yTL; }
-        if (auto xBR = element->GetRectNode().GetBR().x; max.x < xBR) { max.x = xBR; }
-        if (auto yBR = element->GetRectNode().GetBR().y; max.y < yBR) { max.y = yBR; }
-    }
-    auto rectNodes = ImRect(min, max);
+    auto rectNodes = nodeTable.GetUnion();
 
     // Scaling to fit.
     auto rX = rectCanvas.GetWidth() / rectNodes.GetWidth();
@@ -965,60 +953,76 @@ void CoreDiagram::DragNodeMulti()
 void CoreDiagram::UpdateNodeFlags()
 {
     hovNode = nullptr; // Important.
+    for (const auto& node : visibleNodes) // Only these can have the flags set.
+    {
+        node->GetFlagSet().UnsetFlag(NodeFlag::Visible | NodeFlag::Hovered);
+    }
+    visibleNodes.clear();
     if (coreNodeVec.empty())
     {
         return;
     }
 
-    ImVec2 offset = position + scroll;
-    ImRect canvas(position, position + size);
-    for (auto it = coreNodeVec.rbegin(); it != coreNodeVec.rend(); ++it)
-    {
-        CoreNode* node = *it;
+    // Tests run in diagram coordinates against the rectangle tables, in drawing order.
+    const ImVec2 offset = position + scroll;
+    const ImRect canvas(position, position + size);
+    const ImRect view((canvas.Min - offset) / scale, (canvas.Max - offset) / scale);
 
-        // Unset hovered flag
-        node->GetFlagSet().UnsetFlag(NodeFlag::Hovered);
-
-        // Node and io areas
-        ImRect nodeArea = node->GetRectNode();
-        nodeArea.Min *= scale;
-        nodeArea.Max *= scale;
-        nodeArea.Translate(offset);
-        nodeArea.ClipWith(canvas);
-        auto inputArea = ImRect(node->GetInputVec().front().GetRectPin().Min, node->GetInputVec().back().GetRectPin().Max);
-        inputArea.Min *= scale;
-        inputArea.Max *= scale;
-        inputArea.Translate(offset);
-        inputArea.ClipWith(canvas);
-        auto outputArea = ImRect(node->GetOutputVec().front().GetRectPin().Min, node->GetOutputVec().back().GetRectPin().Max);
-        outputArea.Min *= scale;
-        outputArea.Max *= scale;
-        outputArea.Translate(offset);
-        outputArea.ClipWith(canvas);
-
-        // Visibility
-        if (canvas.Overlaps(nodeArea) || canvas.Overlaps(inputArea) || canvas.Overlaps(outputArea))
-        {
-            node->GetFlagSet().SetFlag(NodeFlag::Visible);
-        }
-        else
+    // Zoomed in, the grid returns the few nodes under the canvas. Zoomed out, one pass over the table is cheaper.
+    if (spatialIndex.GetCellNum(view) < static_cast<double>(spatialIndex.GetCellNum()))
+    {
+        spatialIndex.Query(view, visibleNodes);
+        visibleNodes.erase(std::remove_if(visibleNodes.begin(), visibleNodes.end(),
+            [this, &view](const CoreNode* node) { return boundsTable.Overlaps(nodeIndex.at(node), view) == false; }), visibleNodes.end());
+    }
+    else
+    {
+        boundsTable.FindOverlapping(view, visibleIndices);
+        for (const auto& i : visibleIndices)
         {
-            node->GetFlagSet().UnsetFlag(NodeFlag::Visible);
-            continue;
+            visibleNodes.push_back(coreNodeVec[i]);
         }
+    }
+    for (const auto& node : visibleNodes)
+    {
+        node->GetFlagSet().SetFlag(NodeFlag::Visible);
+    }
 
-        // Hovered Node Condition
-        if (state != State::None && hovNode == nullptr &&
-            (nodeArea.Contains(mousePos) || inputArea.Contains(mousePos) || outputArea.Contains(mousePos)))
+    // Hovered Node Condition: the topmost node whose body or pins contain the cursor.
+    if (state != State::None)
+    {
+        const ImVec2 cursor = (mousePos - offset) / scale;
+        auto isUnder = [&cursor](const CoreNode* node)
         {
-            hovNode = node;
-            hovNode->GetFlagSet().SetFlag(NodeFlag::Hovered);
+            auto inputArea = ImRect(node->GetInputVec().front().GetRectPin().Min, node->GetInputVec().back().GetRectPin().Max);
+            auto outputArea = ImRect(node->GetOutputVec().front().GetRectPin().Min, node->GetOutputVec().back().GetRectPin().Max);
+            return node->GetRectNode().Contains(cursor) || inputArea.Contains(cursor) || outputArea.Contains(cursor);
+        };
+        for (int i = boundsTable.FindLastContaining(cursor, boundsTable.GetSize()); i >= 0; i = boundsTable.FindLastContaining(cursor, i))
+        {
+            if (isUnder(coreNodeVec[i]) == true)
+            {
+                hovNode = coreNodeVec[i];
+                hovNode->GetFlagSet().SetFlag(NodeFlag::Hovered);
+                break;
+            }
         }
+    }
 
-        // Selecting
+    // Selecting
+    selectedIndices.clear();
+    if (state == State::Selecting)
+    {
+        ImRect selection((rectSelecting.Min - offset) / scale, (rectSelecting.Max - offset) / scale);
+        selection.ClipWith(view);
+        nodeTable.FindOverlapping(selection, selectedIndices);
+    }
+    for (auto it = visibleNodes.rbegin(); it != visibleNodes.rend(); ++it)
+    {
+        CoreNode* node = *it;
         if (state == State::Selecting)
         {
-            if (rectSelecting.Overlaps(nodeArea))
+            if (std::binary_search(selectedIndices.begin(), selectedIndices.end(), nodeIndex.at(node)) == true)
             {
                 node->GetFlagSet().SetFlag(NodeFlag::Selected);
                 continue;
@@ -1176,46 +1180,15 @@ void CoreDiagram::HighlightNode()
         highlightedNode->GetFlagSet().UnsetFlag(NodeFlag::Highlighted);
     }
     iNode->GetFlagSet().SetFlag(NodeFlag::Highlighted);
-    if (iNode != highlightedNode)
-    {
-        modifFlag = true;
-    }
     highlightedNode = iNode; // Set highlighted node.
     if (coreNodeVec.back() != iNode)
     {
         coreNodeVec.erase(std::find(coreNodeVec.begin(), coreNodeVec.end(), iNode));
         coreNodeVec.push_back(iNode); // Bring iNode to front.
+        IndexNodeOrder();
     }
 }
 
-std::string CoreDiagram::CreateUniqueName(const std::string& libName) const
-{
-    std::string name = libName;
-    unsigned int i = 0;
-    bool nameFlag = true;
-    while (nameFlag == true)
-    {
-        nameFlag = false;
-        for (auto n : coreNodeVec)
-        {
-            if (n->GetName() == name)
-            {
-                nameFlag = true;
-                if (i != 0)
-                {
-                    for (int k = 0; k < std::to_string(i).length(); k++)
-                    {
-                        name.pop_back();
-                    }
-                }
-                i += 1;
-                name += std::to_string(i);
-            }
-        }
-    }
-    return name;
-}
-
 bool CoreDiagram::ConnectionRules([[maybe_unused]] const CoreNode* inputNode, const CoreNode* outputNode, const CoreNodeInput* input, const CoreNodeOutput* output) const
 {
     if (input->GetTargetNode() != nullptr && input->GetTargetNode() == outputNode) // If there is already a connection.
@@ -1265,6 +1238,7 @@ void CoreDiagram::SortNodeOrder()
         coreNodeVec[i] = node;
         i++;
     }
+    IndexNodeOrder();
 }
 
 void CoreDiagram::PopupMenu()
@@ -1281,23 +1255,6 @@ void CoreDiagram::PopupMenu()
     ImGui::PopStyleVar();
 }
 
-void CoreDiagram::EraseLink(const CoreNodeInput* input)
-{
-    auto it = linkVec.begin();
-    while (it != linkVec.end())
-    {
-        if (it->inputPort == input)
-        {
-            it = linkVec.erase(it);
-            return;
-        }
-        else
-        {
-            ++it;
-        }
-    }
-}
-
 bool CoreDiagram::IsLinkVisible(ImVec2 pInput, ImVec2 pOutput) const
 {
     if (rectCanvas.Contains(pInput) || rectCanvas.Contains(pOutput))
@@ -1307,8 +1264,11 @@ bool CoreDiagram::IsLinkVisible(ImVec2 pInput, ImVec2 pOutput) const
     return false;
 }
 
-void CoreDiagram::DrawLinks() const
+void CoreDiagram::DrawLinks()
 {
+    const NodeDetail detail = GetDetail();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ArenaSet<unsigned long long> lodLinks(64, std::hash<unsigned long long>(), std::equal_to<unsigned long long>(), ArenaAllocator<unsigned long long>(frameArena));
     for (const auto& link : linkVec)
     {
         const ImVec2 offset = position + scroll;
@@ -1347,65 +1307,124 @@ void CoreDiagram::DrawLinks() const
         {
             continue;
         }
-
-        float linkDistance = std::sqrt((pInput.x - pOutput.x) * (pInput.x - pOutput.x) + (pInput.y - pOutput.y) * (pInput.y - pOutput.y)) / 150.0f;
-        float rounding = 25.0f * linkDistance / scale;
-        float dHandle = 15.0f * scale;
-        
-        if (link.type == LinkType::BINV_LEFT)
-        {
-            DrawLinkBezier(link, pInput, pOutput, rounding, true);
-        }
-        else if (link.type == LinkType::BINV_RIGHT_OVER || link.type == LinkType::BINV_RIGHT_UNDER || link.type == LinkType::BINV_RIGHT_MID)
+        if (detail == NodeDetail::Flat)
         {
-            DrawLinkBNInv(link, pInput, pOutput, dHandle, true);
-        }
-        else if (link.type == LinkType::IINV_RIGHT_OVER || link.type == LinkType::IINV_LEFT_OVER ||
-            link.type == LinkType::IINV_RIGHT_UNDER || link.type == LinkType::IINV_LEFT_UNDER ||
-            link.type == LinkType::OINV_RIGHT_OVER || link.type == LinkType::OINV_LEFT_OVER ||
-            link.type == LinkType::OINV_RIGHT_UNDER || link.type == LinkType::OINV_LEFT_UNDER)
-        {
-            DrawLinkIOInv(link, pInput, pOutput, dHandle);
-        }
-        else if (link.type == LinkType::IINV_MID || link.type == LinkType::OINV_MID)
-        {
-            DrawLinkBezier(link, pInput, pOutput, 0.0f);
-        }
-        else if (link.type == LinkType::NINV_RIGHT)
-        {
-            DrawLinkBezier(link, pInput, pOutput, rounding);
+            // Straight segments, links between the same cells are drawn once.
+            const ImVec2 cIn = (pInput - rectCanvas.Min) / lodCell;
+            const ImVec2 cOut = (pOutput - rectCanvas.Min) / lodCell;
+            const auto xIn = static_cast<unsigned short>(static_cast<int>(std::floor(cIn.x)));
+            const auto yIn = static_cast<unsigned short>(static_cast<int>(std::floor(cIn.y)));
+            const auto xOut = static_cast<unsigned short>(static_cast<int>(std::floor(cOut.x)));
+            const auto yOut = static_cast<unsigned short>(static_cast<int>(std::floor(cOut.y)));
+            if (xIn == xOut && yIn == yOut)
+            {
+                continue;
+            }
+            const unsigned long long key = static_cast<unsigned long long>(xIn) << 48 | static_cast<unsigned long long>(yIn) << 32 |
+                static_cast<unsigned long long>(xOut) << 16 | yOut;
+            if (lodLinks.insert(key).second == true)
+            {
+                drawList->AddLine(pInput, pOutput, link.color, link.thickness * scale);
+            }
+            continue;
         }
-        else if (link.type == LinkType::NINV_LEFT_OVER || link.type == LinkType::NINV_LEFT_UNDER || link.type == LinkType::NINV_LEFT_MID)
+
+        const unsigned long long signature = GetLinkSignature(link);
+        if (drawCache.Replay(drawList, link.inputPort, signature, offset) == true)
         {
-            DrawLinkBNInv(link, pInput, pOutput, dHandle);
+            continue;
         }
+        drawCache.BeginRecord(drawList, offset);
+        DrawLink(link, pInput, pOutput);
+        drawCache.EndRecord(drawList, link.inputPort, signature);
+    }
+}
+
+unsigned long long CoreDiagram::GetLinkSignature(const Link& link) const
+{
+    // Diagram coordinates, the scroll is applied at the replay.
+    unsigned long long hash = HashDraw(hashDrawSeed, GetDetail());
+    hash = HashDraw(hash, link.inputPort->GetPosition());
+    hash = HashDraw(hash, link.outputPort->GetPosition());
+    hash = HashDraw(hash, link.inputNode->GetFlagSet().HasFlag(NodeFlag::Collapsed));
+    hash = HashDraw(hash, link.outputNode->GetFlagSet().HasFlag(NodeFlag::Collapsed));
+    hash = HashDraw(hash, link.type);
+    hash = HashDraw(hash, link.color.Value);
+    hash = HashDraw(hash, link.thickness);
+    hash = HashDraw(hash, link.xSepIn);
+    hash = HashDraw(hash, link.xSepOut);
+    hash = HashDraw(hash, link.ykSep);
+    hash = HashDraw(hash, link.inputNode->GetRectNode());
+    hash = HashDraw(hash, link.outputNode->GetRectNode());
+    for (const auto& input : link.inputNode->GetInputVec()) // Lines between the two nodes share the space under them.
+    {
+        hash = HashDraw(hash, input.GetTargetNodeOutput());
+    }
+    return hash;
+}
+
+void CoreDiagram::DrawLink(const Link& link, ImVec2 pInput, ImVec2 pOutput)
+{
+    float linkDistance = std::sqrt((pInput.x - pOutput.x) * (pInput.x - pOutput.x) + (pInput.y - pOutput.y) * (pInput.y - pOutput.y)) / 150.0f;
+    float rounding = 25.0f * linkDistance / scale;
+    float dHandle = 15.0f * scale;
+    
+    if (link.type == LinkType::BINV_LEFT)
+    {
+        DrawLinkBezier(link, pInput, pOutput, rounding, true);
+    }
+    else if (link.type == LinkType::BINV_RIGHT_OVER || link.type == LinkType::BINV_RIGHT_UNDER || link.type == LinkType::BINV_RIGHT_MID)
+    {
+        DrawLinkBNInv(link, pInput, pOutput, dHandle, true);
+    }
+    else if (link.type == LinkType::IINV_RIGHT_OVER || link.type == LinkType::IINV_LEFT_OVER ||
+        link.type == LinkType::IINV_RIGHT_UNDER || link.type == LinkType::IINV_LEFT_UNDER ||
+        link.type == LinkType::OINV_RIGHT_OVER || link.type == LinkType::OINV_LEFT_OVER ||
+        link.type == LinkType::OINV_RIGHT_UNDER || link.type == LinkType::OINV_LEFT_UNDER)
+    {
+        DrawLinkIOInv(link, pInput, pOutput, dHandle);
+    }
+    else if (link.type == LinkType::IINV_MID || link.type == LinkType::OINV_MID)
+    {
+        DrawLinkBezier(link, pInput, pOutput, 0.0f);
+    }
+    else if (link.type == LinkType::NINV_RIGHT)
+    {
+        DrawLinkBezier(link, pInput, pOutput, rounding);
+    }
+    else if (link.type == LinkType::NINV_LEFT_OVER || link.type == LinkType::NINV_LEFT_UNDER || link.type == LinkType::NINV_LEFT_MID)
+    {
+        DrawLinkBNInv(link, pInput, pOutput, dHandle);
     }
 }
 
 void CoreDiagram::SetLinkProperties()
 {
-    for (auto& link : linkVec)
+    // Routing is kept in diagram coordinates, so only the links around changed nodes are rerouted.
+    std::vector<int> affected = GetRoutingAffectedLinks();
+    for (const auto& i : affected)
     {
+        const Link& link = linkVec[i];
         link.inputPort->SetLinkDir(0);
         link.inputPort->SetLinkSepX(0);
         link.inputPort->SetLinkSepY(0);
         link.inputPort->SetTargetLinkDir(0);
         link.inputPort->SetTargetLinkSep(0);
     }
-    for (auto& link : linkVec)
+    for (const auto& i : affected)
     {
+        Link& link = linkVec[i];
         link.type = LinkType::NONE;
         link.color = ImColor(1.0f, 1.0f, 1.0f, 1.0f);
-        link.thickness = 2.0f * scale;
-        link.xSepIn = link.inputPort->GetRectPort().GetHeight() * scale;
-        link.xSepOut = link.inputPort->GetRectPort().GetHeight() * scale;
+        link.thickness = 2.0f;
+        link.xSepIn = link.inputPort->GetRectPort().GetHeight();
+        link.xSepOut = link.inputPort->GetRectPort().GetHeight();
         link.ykSep = 0;
-        const ImVec2 offset = position + scroll;
-        auto rInput = ImRect(link.inputNode->GetRectNode().Min * scale + offset, link.inputNode->GetRectNode().Max * scale + offset);
-        auto rOutput = ImRect(link.outputNode->GetRectNode().Min * scale + offset, link.outputNode->GetRectNode().Max * scale + offset);
-        float yInput = (link.inputPort->GetRectPin().GetCenter() * scale + offset).y;
-        float yOutput = (link.inputPort->GetTargetNodeOutput()->GetRectPin().GetCenter() * scale + offset).y;
-        float yMargin = 30.0f * scale;
+        auto rInput = link.inputNode->GetRectNode();
+        auto rOutput = link.outputNode->GetRectNode();
+        float yInput = link.inputPort->GetRectPin().GetCenter().y;
+        float yOutput = link.inputPort->GetTargetNodeOutput()->GetRectPin().GetCenter().y;
+        float yMargin = 30.0f;
         bool inputNodeInverted = link.inputNode->IsPortInverted();
         bool outputNodeInverted = link.outputNode->IsPortInverted();
         if (inputNodeInverted && outputNodeInverted)
@@ -1416,7 +1435,7 @@ void CoreDiagram::SetLinkProperties()
             }
             if (rInput.Max.x > rOutput.Min.x)
             {
-                float nodeMargin = 24.0f * scale;
+                float nodeMargin = 24.0f;
                 if (rInput.Max.y + nodeMargin < rOutput.Min.y)
                 {
                     link.type = LinkType::BINV_RIGHT_OVER;
@@ -1512,7 +1531,7 @@ void CoreDiagram::SetLinkProperties()
         }
         else if (rInput.Min.x < rOutput.Max.x)
         {
-            float nodeMargin = 24.0f * scale;
+            float nodeMargin = 24.0f;
             if (rInput.Max.y + nodeMargin < rOutput.Min.y)
             {
                 link.type = LinkType::NINV_LEFT_OVER;
@@ -1544,7 +1563,7 @@ void CoreDiagram::DrawFreeLink() const
     {
         Link link;
         link.color = ImColor(0.996f, 0.431f, 0.000f, 1.0f);
-        link.thickness = 2.0f * scale;
+        link.thickness = 2.0f;
         DrawLinkBezier(link, inputFreeLink, outputFreeLink, 0.0f);
     }
 }
@@ -1559,11 +1578,12 @@ void CoreDiagram::DrawLinkBezier(const Link& link, ImVec2 pInput, ImVec2 pOutput
         ImVec2 p2 = pInput + handle;
         ImVec2 p3 = pOutput - handle;
         ImVec2 p4 = pOutput;
-        drawList->AddBezierCurve(p1, p2, p3, p4, link.color, link.thickness);
+        const int segmentNum = GetDetail() == NodeDetail::Full ? 0 : 6; // Zero lets ImGui tessellate by length.
+        drawList->AddBezierCurve(p1, p2, p3, p4, link.color, link.thickness * scale, segmentNum);
     }
 }
 
-void CoreDiagram::DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle) const
+void CoreDiagram::DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle)
 {
     float xMax = ImMax(pInput.x, pOutput.x);
     float xMin = ImMin(pInput.x, pOutput.x);
@@ -1574,23 +1594,23 @@ void CoreDiagram::DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
     // Input inverted.
     if (link.type == LinkType::IINV_LEFT_OVER || link.type == LinkType::IINV_LEFT_UNDER)
     {
-        x1 = xMax - xMargin + link.xSepOut;
+        x1 = xMax - xMargin + link.xSepOut * scale;
         x2 = x1 + dHandle;
     }
     if (link.type == LinkType::IINV_RIGHT_OVER || link.type == LinkType::IINV_RIGHT_UNDER)
     {
-        x1 = xMax - xMargin + link.xSepIn;
+        x1 = xMax - xMargin + link.xSepIn * scale;
         x2 = x1 + dHandle;
     }
     // Output inverted.
     if (link.type == LinkType::OINV_LEFT_OVER || link.type == LinkType::OINV_LEFT_UNDER)
     {
-        x1 = xMin + xMargin - link.xSepIn;
+        x1 = xMin + xMargin - link.xSepIn * scale;
         x2 = x1 - dHandle;
     }
     if (link.type == LinkType::OINV_RIGHT_OVER || link.type == LinkType::OINV_RIGHT_UNDER)
     {
-        x1 = xMin + xMargin - link.xSepOut;
+        x1 = xMin + xMargin - link.xSepOut * scale;
         x2 = x1 - dHandle;
     }
     // Input is over the output.
@@ -1609,7 +1629,7 @@ void CoreDiagram::DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
     float y1 = pInput.y + dHandle;
     float y2 = pOutput.y - dHandle;
 
-    std::vector<ImVec2> points;
+    ArenaVector<ImVec2> points{ ArenaAllocator<ImVec2>(frameArena) };
     points.reserve(8);
     points.push_back(pInput);
     points.push_back(ImVec2(x1, pInput.y));
@@ -1621,21 +1641,26 @@ void CoreDiagram::DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
     points.push_back(pOutput);
 
     ImDrawList* drawList = ImGui::GetWindowDrawList();
-    drawList->AddBezierQuadratic(points[0], (points[0] + points[1]) * 0.5f, points[1], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[1], points[2], points[3], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[3], (points[3] + points[4]) * 0.5f, points[4], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[4], points[5], points[6], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[6], (points[6] + points[7]) * 0.5f, points[7], link.color, link.thickness);
+    if (GetDetail() != NodeDetail::Full)
+    {
+        drawList->AddPolyline(points.data(), static_cast<int>(points.size()), link.color, ImDrawFlags_None, link.thickness * scale);
+        return;
+    }
+    drawList->AddBezierQuadratic(points[0], (points[0] + points[1]) * 0.5f, points[1], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[1], points[2], points[3], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[3], (points[3] + points[4]) * 0.5f, points[4], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[4], points[5], points[6], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[6], (points[6] + points[7]) * 0.5f, points[7], link.color, link.thickness * scale);
 }
 
-void CoreDiagram::DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle, bool invert) const
+void CoreDiagram::DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle, bool invert)
 {
     const ImVec2 offset = position + scroll;
     auto rInputNode = ImRect(link.inputNode->GetRectNode().Min * scale + offset, link.inputNode->GetRectNode().Max * scale + offset);
     auto rOutputNode = ImRect(link.outputNode->GetRectNode().Min * scale + offset, link.outputNode->GetRectNode().Max * scale + offset);
 
     // Unique lines between two nodes.
-    std::vector<CoreNodeOutput*> vec;
+    ArenaVector<CoreNodeOutput*> vec{ ArenaAllocator<CoreNodeOutput*>(frameArena) };
     for (const auto& input : link.inputNode->GetInputVec())
     {
         if (input.GetTargetNode() == link.outputNode)
@@ -1643,7 +1668,8 @@ void CoreDiagram::DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
             vec.push_back(input.GetTargetNodeOutput());
         }
     }
-    auto numberOfUniqueLines = (int)std::set<CoreNodeOutput*>(vec.begin(), vec.end()).size();
+    std::sort(vec.begin(), vec.end());
+    auto numberOfUniqueLines = (int)(std::unique(vec.begin(), vec.end()) - vec.begin());
 
     float x1 = 0;
     float x2 = 0;
@@ -1652,16 +1678,16 @@ void CoreDiagram::DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
     float xMargin = dHandle;
     if (invert == false)
     {
-        x1 = pInput.x + xMargin - link.xSepIn;
+        x1 = pInput.x + xMargin - link.xSepIn * scale;
         x2 = x1 - dHandle;
-        x3 = pOutput.x - xMargin + link.xSepOut;
+        x3 = pOutput.x - xMargin + link.xSepOut * scale;
         x4 = x3 + dHandle;
     }
     else
     {
-        x1 = pInput.x - xMargin + link.xSepIn;
+        x1 = pInput.x - xMargin + link.xSepIn * scale;
         x2 = x1 + dHandle;
-        x3 = pOutput.x + xMargin - link.xSepOut;
+        x3 = pOutput.x + xMargin - link.xSepOut * scale;
         x4 = x3 - dHandle;
     }
 
@@ -1704,7 +1730,7 @@ void CoreDiagram::DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
         y5 = pOutput.y + dHandle;
     }
 
-    std::vector<ImVec2> points;
+    ArenaVector<ImVec2> points{ ArenaAllocator<ImVec2>(frameArena) };
     points.reserve(14);
     points.push_back(pInput);
     points.push_back(ImVec2(x1, pInput.y));
@@ -1722,15 +1748,20 @@ void CoreDiagram::DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput,
     points.push_back(pOutput);
 
     ImDrawList* drawList = ImGui::GetWindowDrawList();
-    drawList->AddBezierQuadratic(points[0], (points[0] + points[1]) * 0.5f, points[1], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[1], points[2], points[3], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[3], (points[3] + points[4]) * 0.5f, points[4], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[4], points[5], points[6], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[6], (points[6] + points[7]) * 0.5f, points[7], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[7], points[8], points[9], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[9], (points[9] + points[10]) * 0.5f, points[10], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[10], points[11], points[12], link.color, link.thickness);
-    drawList->AddBezierQuadratic(points[12], (points[12] + points[13]) * 0.5f, points[13], link.color, link.thickness);
+    if (GetDetail() != NodeDetail::Full)
+    {
+        drawList->AddPolyline(points.data(), static_cast<int>(points.size()), link.color, ImDrawFlags_None, link.thickness * scale);
+        return;
+    }
+    drawList->AddBezierQuadratic(points[0], (points[0] + points[1]) * 0.5f, points[1], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[1], points[2], points[3], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[3], (points[3] + points[4]) * 0.5f, points[4], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[4], points[5], points[6], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[6], (points[6] + points[7]) * 0.5f, points[7], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[7], points[8], points[9], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[9], (points[9] + points[10]) * 0.5f, points[10], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[10], points[11], points[12], link.color, link.thickness * scale);
+    drawList->AddBezierQuadratic(points[12], (points[12] + points[13]) * 0.5f, points[13], link.color, link.thickness * scale);
 }
 
 void CoreDiagram::SetInputSepDown(Link& link) const
@@ -1789,25 +1820,16 @@ void CoreDiagram::SetInputSepUp(Link& link) const
 
 void CoreDiagram::SetOutputSepUp(Link& link) const
 {
-    // Collect all inputs related with the output node.
-    std::vector<CoreNodeInput*> inputVec;
-    for (const auto& node : coreNodeVec)
-    {
-        for (auto& input : node->GetInputVec())
-        {
-            if (input.GetTargetNode() == link.outputNode)
-            {
-                inputVec.push_back(&input);
-            }
-        }
-    }
+    // All inputs related with the output node.
+    const auto& consumers = GetConsumers(link.outputNode);
 
     int kSep = 1;
     while (true)
     {
         bool full = false;
-        for (const auto& input : inputVec)
+        for (const auto& consumer : consumers)
         {
+            const CoreNodeInput* input = consumer.input;
             if (input->GetTargetLinkSep() == kSep &&
                 (input->GetTargetNodeOutput()->GetOrder() >= link.outputPort->GetOrder() && input->GetTargetLinkDir() == 1) == false &&
                 input->GetTargetNodeOutput() != link.outputPort) // If it is the same output, no need to seperate.
@@ -1829,25 +1851,16 @@ void CoreDiagram::SetOutputSepUp(Link& link) const
 
 void CoreDiagram::SetOutputSepDown(Link& link) const
 {
-    // Collect all inputs related with the output node.
-    std::vector<CoreNodeInput*> inputVec;
-    for (const auto& node : coreNodeVec)
-    {
-        for (auto& input : node->GetInputVec())
-        {
-            if (input.GetTargetNode() == link.outputNode)
-            {
-                inputVec.push_back(&input);
-            }
-        }
-    }
+    // All inputs related with the output node.
+    const auto& consumers = GetConsumers(link.outputNode);
 
     int kSep = 1;
     while (true)
     {
         bool full = false;
-        for (const auto& input : inputVec)
+        for (const auto& consumer : consumers)
         {
+            const CoreNodeInput* input = consumer.input;
             if (input->GetTargetNode() == link.outputNode && input->GetTargetLinkSep() == kSep &&
                 (input->GetTargetNodeOutput()->GetOrder() <= link.outputPort->GetOrder() && input->GetTargetLinkDir() == -1) == false &&
                 input->GetTargetNodeOutput() != link.outputPort) // If it is the same output, no need to seperate.
@@ -10,8 +10,12 @@
 #ifndef COREDIAGRAM_HPP
 #define COREDIAGRAM_HPP
 
+#include "CoreGraph.hpp"
 #include "CoreLibrary.hpp"
-#include <set>
+#include "CoreDrawCache.hpp"
+#include "CoreArena.hpp"
+#include "CoreRecovery.hpp"
+#include "imgui_stdlib.h"
 #include <cmath>
 
 enum class State
@@ -27,26 +31,26 @@ enum class State
     Selecting
 };
 
-class CoreDiagram
+class CoreDiagram : public CoreGraph
 {
 private:
     bool mNodeDrag = false; // For node drag modification.
-    bool modifFlag = false; // Modification flag.
 
     CoreLibrary coreLib;
     State state = State::Default;
     float scale = 1.0f;
     const float scaleMin = 0.10f;
     const float scaleMax = 2.0f;
+    const float scaleSimple = 0.5f;         // Below this, no text and plain pins.
+    const float scaleFlat = 0.25f;          // Below this, flat quads and straight links.
+    const float lodCell = 2.0f;             // Pixels merged into one quad or link end at the flat detail.
+    NodeDetail GetDetail() const;
     ImVec2 position;
     ImVec2 size;
     ImVec2 scroll;
     ImVec2 mousePos;
-    std::vector<CoreNode*> coreNodeVec;
-    std::vector<CoreNode*> exeOrder; // Execution order.
     CoreNode* highlightedNode = nullptr;
     void HighlightNode();
-    std::string CreateUniqueName(const std::string& libName) const;
 
     // Update canvas
     ImRect rectCanvas;
@@ -60,6 +64,7 @@ private:
     bool draggingOutOfCanvas = false;
     ImVec2 distFromClickToCenter;
     ImVec2 clickPosAtTheEdge;
+    ImVec2 dragOrigin;                      // Position of the dragged node when the drag started.
     void DragNodeSingle();
     void DragNodeMulti();
     
@@ -75,9 +80,54 @@ private:
     void MouseRightButtonRelease();
     void KeyboardPressDelete();
 
+    // Undo history. The edits refer to nodes by name, pointers do not survive deleting and restoring a node.
+    CoreJournal journal;
+    struct LinkRecord
+    {
+        std::string inputNode;
+        int inputPort = 0;
+        std::string outputNode;
+        int outputPort = 0;
+        void Write(RecoveryRecord& record) const;
+        void Read(RecoveryRecord& record);
+    };
+    class MoveEdit;
+    class LinkEdit;
+    class NodesEdit;
+    class ParamEdit;
+    class RenameEdit;
+    class ToggleEdit;
+    class OrderEdit;
+    LinkRecord GetLinkRecord(const Link& link) const;
+    LinkRecord GetLinkRecord(const CoreNode* node, const CoreNodeInput& input) const;
+    bool FindLink(const LinkRecord& record, Link& link) const; // False if a node or a port is missing.
+    bool IsLinkValid(const LinkRecord& record, bool linked, const std::vector<std::string>& inserted = std::vector<std::string>()) const; // The input is linked to the output, or is free.
+    bool HasNodes(const std::vector<std::string>& names) const;
+    void ConnectLink(const LinkRecord& record);
+    void DisconnectLink(const LinkRecord& record);
+    void Connect(const Link& link);         // Applied and recorded.
+    void Disconnect(CoreNode* node, CoreNodeInput* input);
+    void DeleteNodes(const std::vector<CoreNode*>& nodes);
+    void RecordMove();                      // Recorded after being applied.
+    void RecordAdd(CoreNode* node);
+    void RecordParam(CoreNode* node, int param, double before);
+    void RecordRename(const std::string& before, const std::string& after);
+    void RecordToggle(const CoreNode* node, bool collapse);
+    void RecordOrder(int i, int j);
+    void ToggleCollapse(CoreNode* node);
+    void RemoveNodes(const std::vector<CoreNode*>& nodes);
+    void InsertNodes(const std::string& nodeList, const std::vector<int>& nodeOrders, const std::vector<int>& exeOrders);
+    void ResetInteraction();
+
+    // Frame memory
+    CoreArena frameArena;                   // Transient containers of the frame, reset at the start of Update.
+    long long heapAllocNum = 0;             // Heap allocations during the last Update.
+
     // Draw canvas elements
     void DrawCanvasElements();
-    void DrawNodes() const;
+    CoreDrawCache drawCache;                // Retained vertices of the nodes and links.
+    void DrawNodes();
+    std::vector<unsigned char> lodCoverage;
     ImRect rectSelecting;
     void DrawSelecting() const;
     void PrintInfo();
@@ -87,6 +137,9 @@ private:
     CoreNode* iNode = nullptr;              // Node under interaction
     CoreNodeInput* iNodeInput = nullptr;    // Node input under interaction
     CoreNodeOutput* iNodeOutput = nullptr;  // Node output under interaction
+    std::vector<CoreNode*> visibleNodes;    // Nodes under the canvas, in drawing order.
+    std::vector<int> visibleIndices;
+    std::vector<int> selectedIndices;
     void UpdateNodeFlags();
     void UpdateInputFlags(CoreNode* node);
     void UpdateOutputFlags(CoreNode* node);
@@ -94,95 +147,40 @@ private:
     void SortNodeOrder();
     void PopupMenu();
 
-    // Network
-    enum class LinkType;
-    struct Link
-    {
-        CoreNode* inputNode;
-        CoreNode* outputNode;
-        CoreNodeInput* inputPort;
-        CoreNodeOutput* outputPort;
-        LinkType type;
-        ImColor color;
-        float thickness;
-        float xSepIn;
-        float xSepOut;
-        float ykSep = 0;
-        void Save(pugi::xml_node& xmlNode) const
-        {
-            auto link = xmlNode.append_child("link");
-            SaveString(link, "inputNode", inputNode->GetName());
-            SaveString(link, "outputNode", outputNode->GetName());
-            SaveInt(link, "inputPort", inputPort->GetOrder());
-            SaveInt(link, "outputPort", outputPort->GetOrder());
-            SaveInt(link, "type", (int)type);
-            SaveImColor(link, "color", color);
-            SaveFloat(link, "thickness", thickness);
-            SaveFloat(link, "xSepIn", xSepIn);
-            SaveFloat(link, "xSepOut", xSepOut);
-            SaveFloat(link, "ykSep", ykSep);
-        }
-        void Load(const pugi::xml_node& xmlNode)
-        {
-            type = (LinkType)LoadInt(xmlNode, "type");
-            color = LoadImColor(xmlNode, "color");
-            thickness = LoadFloat(xmlNode, "thickness");
-            xSepIn = LoadFloat(xmlNode, "xSepIn");
-            xSepOut = LoadFloat(xmlNode, "xSepOut");
-            ykSep = LoadFloat(xmlNode, "ykSep");
-        }
-    };
-    std::vector<Link> linkVec;
-    void EraseLink(const CoreNodeInput* input);
+    // Properties
+    std::string nameEdited;
+    bool editingName = false;
+    void EditName(CoreNode* node);
+
+    // Links
     bool IsLinkVisible(ImVec2 pInput, ImVec2 pOutput) const;
-    void DrawLinks() const;
+    void DrawLinks();
+    void DrawLink(const Link& link, ImVec2 pInput, ImVec2 pOutput);
+    unsigned long long GetLinkSignature(const Link& link) const;
     ImVec2 inputFreeLink;
     ImVec2 outputFreeLink;
     void SetLinkProperties();
     void DrawFreeLink() const;
     void DrawLinkBezier(const Link& link, ImVec2 pInput, ImVec2 pOutput, float rounding, bool invert = false) const;
-    void DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle) const;
-    void DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle, bool invert = false) const;
+    void DrawLinkIOInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle);
+    void DrawLinkBNInv(const Link& link, ImVec2 pInput, ImVec2 pOutput, float dHandle, bool invert = false);
     void SetInputSepUp(Link& link) const;
     void SetInputSepDown(Link& link) const;
     void SetOutputSepUp(Link& link) const;
     void SetOutputSepDown(Link& link) const;
     void SetNodeSep(Link& link) const;
-    enum class LinkType
-    {
-        NONE,
-        // BINV: both nodes inverted.
-        BINV_LEFT,
-        BINV_RIGHT_OVER,
-        BINV_RIGHT_UNDER,
-        BINV_RIGHT_MID,
-        // IINV: only input node inverted.
-        IINV_RIGHT_OVER,
-        IINV_LEFT_OVER,
-        IINV_RIGHT_UNDER,
-        IINV_LEFT_UNDER,
-        IINV_MID,
-        // OINV: only output node inverted.
-        OINV_RIGHT_OVER,
-        OINV_LEFT_OVER,
-        OINV_RIGHT_UNDER,
-        OINV_LEFT_UNDER,
-        OINV_MID,
-        // NINV: No Inversion. Location of input node wrt output node.
-        NINV_RIGHT,
-        NINV_LEFT_OVER,
-        NINV_LEFT_UNDER,
-        NINV_LEFT_MID
-    };
 
 public:
     CoreDiagram() = default;
-    virtual ~CoreDiagram();
+    ~CoreDiagram() override = default;
     void Update();
-    void Save(pugi::xml_node & xmlNode) const;
-    void Load(const pugi::xml_node & xmlNode);
-    bool GetModifFlag() const { return modifFlag; }
-    void ResetModifFlag() { modifFlag = false; }
+    void Load(const pugi::xml_node& xmlNode) override;
+    void Save(CoreBinaryWriter& writer) const override;
+    void Load(const CoreBinaryReader& reader) override;
+    CoreJournal& GetJournal() { return journal; }
+    std::unique_ptr<CoreCommand> ReadCommand(const std::string& type, RecoveryRecord& record); // Edit of the recovery journal, nullptr for another type.
+    bool Undo();
+    bool Redo();
     void DrawLibrary() { coreLib.Draw(); }
     void DrawExplorer();
     void DrawProperties();
@@ -0,0 +1,862 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Diagram Journal                                                                 *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+// Invertible edits of the diagram, recorded in the journal and applied in place by undo and redo.
+
+#include "CoreDiagram.hpp"
+#include <sstream>
+
+static size_t GetMemory(const std::string& str)
+{
+    return sizeof(str) + str.capacity();
+}
+
+template<typename T>
+static void PutVector(RecoveryRecord& record, const std::vector<T>& values)
+{
+    record.Put(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values)
+    {
+        record.Put(value);
+    }
+}
+
+template<typename T>
+static std::vector<T> GetVector(RecoveryRecord& record)
+{
+    std::vector<T> values;
+    const uint32_t size = record.Get<uint32_t>();
+    for (uint32_t i = 0; i < size && record.IsValid() == true; i++)
+    {
+        values.push_back(record.Get<T>());
+    }
+    return values;
+}
+
+static void PutNames(RecoveryRecord& record, const std::vector<std::string>& names)
+{
+    record.Put(static_cast<uint32_t>(names.size()));
+    for (const auto& name : names)
+    {
+        record.PutString(name);
+    }
+}
+
+static std::vector<std::string> GetNames(RecoveryRecord& record)
+{
+    std::vector<std::string> names;
+    const uint32_t size = record.Get<uint32_t>();
+    for (uint32_t i = 0; i < size && record.IsValid() == true; i++)
+    {
+        names.push_back(record.GetString());
+    }
+    return names;
+}
+
+void CoreDiagram::LinkRecord::Write(RecoveryRecord& record) const
+{
+    record.PutString(inputNode);
+    record.Put(static_cast<int32_t>(inputPort));
+    record.PutString(outputNode);
+    record.Put(static_cast<int32_t>(outputPort));
+}
+
+void CoreDiagram::LinkRecord::Read(RecoveryRecord& record)
+{
+    inputNode = record.GetString();
+    inputPort = record.Get<int32_t>();
+    outputNode = record.GetString();
+    outputPort = record.Get<int32_t>();
+}
+
+class CoreDiagram::MoveEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    std::vector<std::string> names;
+    ImVec2 delta;
+    void Apply(ImVec2 d) const
+    {
+        for (const auto& name : names)
+        {
+            if (CoreNode* node = diagram.FindNode(name); node != nullptr)
+            {
+                node->Translate(d);
+            }
+        }
+    }
+
+public:
+    MoveEdit(CoreDiagram& diagram, std::vector<std::string> names, ImVec2 delta) : diagram(diagram), names(std::move(names)), delta(delta) {}
+    void Undo() override { Apply(ImVec2(-delta.x, -delta.y)); }
+    void Redo() override { Apply(delta); }
+    bool IsValid([[maybe_unused]] bool redo) const override { return diagram.HasNodes(names); }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("move");
+        PutNames(record, names);
+        record.Put(delta.x);
+        record.Put(delta.y);
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& record)
+    {
+        std::vector<std::string> names = GetNames(record);
+        const float x = record.Get<float>();
+        const float y = record.Get<float>();
+        return std::make_unique<MoveEdit>(diagram, std::move(names), ImVec2(x, y));
+    }
+    size_t GetMemory() const override
+    {
+        size_t size = sizeof(*this);
+        for (const auto& name : names)
+        {
+            size += ::GetMemory(name);
+        }
+        return size;
+    }
+};
+
+class CoreDiagram::LinkEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    LinkRecord record;
+    bool connect;
+    int exeFirst = 0;
+    std::vector<std::string> exeSlice;  // Part of the execution order that connecting may reorder.
+
+public:
+    LinkEdit(CoreDiagram& diagram, LinkRecord record, bool connect) : diagram(diagram), record(std::move(record)), connect(connect)
+    {
+        if (connect == false)
+        {
+            return;
+        }
+        const int first = diagram.exeIndex.at(diagram.FindNode(this->record.inputNode));
+        const int last = diagram.exeIndex.at(diagram.FindNode(this->record.outputNode));
+        exeFirst = first;
+        for (int i = first; i <= last; i++)
+        {
+            exeSlice.push_back(diagram.exeOrder[i]->GetName());
+        }
+    }
+    void Undo() override
+    {
+        if (connect == false)
+        {
+            diagram.ConnectLink(record);
+            return;
+        }
+        diagram.DisconnectLink(record);
+        for (int i = 0; i < exeSlice.size(); i++)
+        {
+            diagram.exeOrder[exeFirst + i] = diagram.FindNode(exeSlice[i]);
+            diagram.exeIndex[diagram.exeOrder[exeFirst + i]] = exeFirst + i;
+        }
+    }
+    void Redo() override { connect ? diagram.ConnectLink(record) : diagram.DisconnectLink(record); }
+    bool IsValid(bool redo) const override
+    {
+        if (connect == redo)
+        {
+            return diagram.IsLinkValid(record, false);
+        }
+        if (diagram.IsLinkValid(record, true) == false)
+        {
+            return false;
+        }
+        if (redo == true)
+        {
+            return true;
+        }
+        // Undoing the connection puts the same nodes back in their slots of the execution order.
+        if (exeFirst < 0 || exeFirst + exeSlice.size() > diagram.exeOrder.size())
+        {
+            return false;
+        }
+        std::unordered_set<std::string> slice;
+        for (const auto& name : exeSlice)
+        {
+            const CoreNode* node = diagram.FindNode(name);
+            if (node == nullptr || slice.insert(name).second == false ||
+                diagram.exeIndex.at(node) < exeFirst || diagram.exeIndex.at(node) >= exeFirst + static_cast<int>(exeSlice.size()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    void Write(RecoveryRecord& entry) const override
+    {
+        entry.PutString("link");
+        record.Write(entry);
+        entry.Put(connect);
+        entry.Put(static_cast<int32_t>(exeFirst));
+        PutNames(entry, exeSlice);
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& entry)
+    {
+        LinkRecord record;
+        record.Read(entry);
+        auto edit = std::make_unique<LinkEdit>(diagram, std::move(record), false);
+        edit->connect = entry.Get<bool>();
+        edit->exeFirst = entry.Get<int32_t>();
+        edit->exeSlice = GetNames(entry);
+        return edit;
+    }
+    size_t GetMemory() const override
+    {
+        size_t size = sizeof(*this) + ::GetMemory(record.inputNode) + ::GetMemory(record.outputNode);
+        for (const auto& name : exeSlice)
+        {
+            size += ::GetMemory(name);
+        }
+        return size;
+    }
+};
+
+// Added or deleted nodes with the links they had, the nodes are kept as their saved XML.
+class CoreDiagram::NodesEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    bool add;
+    std::vector<std::string> names;
+    std::vector<int> nodeOrders;        // Ascending.
+    std::vector<int> exeOrders;
+    std::vector<LinkRecord> links;
+    std::string nodeList;
+
+    void Insert() const
+    {
+        diagram.InsertNodes(nodeList, nodeOrders, exeOrders);
+        for (const auto& link : links)
+        {
+            diagram.ConnectLink(link);
+        }
+    }
+    void Remove() const
+    {
+        for (const auto& link : links)
+        {
+            diagram.DisconnectLink(link);
+        }
+        std::vector<CoreNode*> nodes;
+        for (const auto& name : names)
+        {
+            nodes.push_back(diagram.FindNode(name));
+        }
+        diagram.RemoveNodes(nodes);
+    }
+
+public:
+    NodesEdit(CoreDiagram& diagram, bool add) : diagram(diagram), add(add) {}
+    void AddLink(LinkRecord link) { links.push_back(std::move(link)); }
+    void AddNodes(const std::vector<CoreNode*>& nodes) // In node vector order, without links.
+    {
+        pugi::xml_document doc;
+        auto list = doc.append_child("nodeList");
+        for (const auto& node : nodes)
+        {
+            names.push_back(node->GetName());
+            nodeOrders.push_back(diagram.nodeIndex.at(node));
+            exeOrders.push_back(diagram.exeIndex.at(node));
+            node->Save(list);
+        }
+        std::ostringstream stream;
+        doc.save(stream, "", pugi::format_raw);
+        nodeList = stream.str();
+    }
+    void Undo() override { add ? Remove() : Insert(); }
+    void Redo() override { add ? Insert() : Remove(); }
+    bool IsValid(bool redo) const override
+    {
+        std::unordered_set<std::string> unique;
+        for (const auto& name : names)
+        {
+            if (unique.insert(name).second == false)
+            {
+                return false;
+            }
+        }
+        if (add == redo)
+        {
+            // Inserted under free names, with their links into free inputs.
+            if (nodeOrders.size() != names.size() || exeOrders.size() != names.size())
+            {
+                return false;
+            }
+            for (const auto& name : names)
+            {
+                if (diagram.FindNode(name) != nullptr)
+                {
+                    return false;
+                }
+            }
+            for (const auto& link : links)
+            {
+                if (diagram.IsLinkValid(link, false, names) == false)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Removed with all of their links, the recorded ones.
+        if (diagram.HasNodes(names) == false)
+        {
+            return false;
+        }
+        for (const auto& link : links)
+        {
+            if (diagram.IsLinkValid(link, true) == false)
+            {
+                return false;
+            }
+        }
+        size_t linkNum = 0;
+        for (const auto& name : names)
+        {
+            const CoreNode* node = diagram.FindNode(name);
+            for (const auto& input : node->GetInputVec())
+            {
+                linkNum += input.GetTargetNode() != nullptr ? 1 : 0;
+            }
+            for (const auto& consumer : diagram.GetConsumers(node))
+            {
+                linkNum += unique.count(consumer.node->GetName()) == 0 ? 1 : 0;
+            }
+        }
+        return linkNum == links.size();
+    }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("nodes");
+        record.Put(add);
+        PutNames(record, names);
+        PutVector(record, nodeOrders);
+        PutVector(record, exeOrders);
+        record.Put(static_cast<uint32_t>(links.size()));
+        for (const auto& link : links)
+        {
+            link.Write(record);
+        }
+        record.PutString(nodeList);
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& record)
+    {
+        auto edit = std::make_unique<NodesEdit>(diagram, record.Get<bool>());
+        edit->names = GetNames(record);
+        edit->nodeOrders = GetVector<int>(record);
+        edit->exeOrders = GetVector<int>(record);
+        const uint32_t linkNum = record.Get<uint32_t>();
+        for (uint32_t i = 0; i < linkNum && record.IsValid() == true; i++)
+        {
+            edit->links.emplace_back();
+            edit->links.back().Read(record);
+        }
+        edit->nodeList = record.GetString();
+        return edit;
+    }
+    size_t GetMemory() const override
+    {
+        size_t size = sizeof(*this) + ::GetMemory(nodeList) + (nodeOrders.size() + exeOrders.size()) * sizeof(int);
+        for (const auto& name : names)
+        {
+            size += ::GetMemory(name);
+        }
+        for (const auto& link : links)
+        {
+            size += sizeof(link) + link.inputNode.capacity() + link.outputNode.capacity();
+        }
+        return size;
+    }
+};
+
+class CoreDiagram::ParamEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    std::string name;
+    int param;
+    double before;
+    double after;
+    void Apply(double value) const
+    {
+        if (CoreNode* node = diagram.FindNode(name); node != nullptr)
+        {
+            node->GetParams().at(param)->Set(value);
+        }
+    }
+
+public:
+    ParamEdit(CoreDiagram& diagram, std::string name, int param, double before, double after) : diagram(diagram), name(std::move(name)), param(param), before(before), after(after) {}
+    void Undo() override { Apply(before); }
+    void Redo() override { Apply(after); }
+    bool IsValid([[maybe_unused]] bool redo) const override
+    {
+        CoreNode* node = diagram.FindNode(name);
+        return node != nullptr && param >= 0 && param < node->GetParams().size();
+    }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("param");
+        record.PutString(name);
+        record.Put(static_cast<int32_t>(param));
+        record.Put(before);
+        record.Put(after);
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& record)
+    {
+        std::string name = record.GetString();
+        const int param = record.Get<int32_t>();
+        const double before = record.Get<double>();
+        const double after = record.Get<double>();
+        return std::make_unique<ParamEdit>(diagram, std::move(name), param, before, after);
+    }
+    size_t GetMemory() const override { return sizeof(*this) + ::GetMemory(name); }
+};
+
+class CoreDiagram::RenameEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    std::string before;
+    std::string after;
+
+public:
+    RenameEdit(CoreDiagram& diagram, std::string before, std::string after) : diagram(diagram), before(std::move(before)), after(std::move(after)) {}
+    void Undo() override { diagram.RenameNode(diagram.FindNode(after), before); }
+    void Redo() override { diagram.RenameNode(diagram.FindNode(before), after); }
+    bool IsValid(bool redo) const override
+    {
+        const std::string& from = redo ? before : after;
+        const std::string& to = redo ? after : before;
+        return diagram.FindNode(from) != nullptr && (to == from || diagram.FindNode(to) == nullptr);
+    }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("rename");
+        record.PutString(before);
+        record.PutString(after);
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& record)
+    {
+        std::string before = record.GetString();
+        std::string after = record.GetString();
+        return std::make_unique<RenameEdit>(diagram, std::move(before), std::move(after));
+    }
+    size_t GetMemory() const override { return sizeof(*this) + ::GetMemory(before) + ::GetMemory(after); }
+};
+
+// Collapsing and port inversion undo themselves.
+class CoreDiagram::ToggleEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    std::string name;
+    bool collapse;
+    void Apply() const
+    {
+        CoreNode* node = diagram.FindNode(name);
+        collapse ? diagram.ToggleCollapse(node) : node->InvertPort();
+    }
+
+public:
+    ToggleEdit(CoreDiagram& diagram, std::string name, bool collapse) : diagram(diagram), name(std::move(name)), collapse(collapse) {}
+    void Undo() override { Apply(); }
+    void Redo() override { Apply(); }
+    bool IsValid([[maybe_unused]] bool redo) const override { return diagram.FindNode(name) != nullptr; }
+    size_t GetMemory() const override { return sizeof(*this) + ::GetMemory(name); }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("toggle");
+        record.PutString(name);
+        record.Put(collapse);
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& record)
+    {
+        std::string name = record.GetString();
+        const bool collapse = record.Get<bool>();
+        return std::make_unique<ToggleEdit>(diagram, std::move(name), collapse);
+    }
+};
+
+class CoreDiagram::OrderEdit : public CoreCommand
+{
+private:
+    CoreDiagram& diagram;
+    int i;
+    int j;
+
+public:
+    OrderEdit(CoreDiagram& diagram, int i, int j) : diagram(diagram), i(i), j(j) {}
+    void Undo() override { diagram.ExchangeExeOrder(i, j); }
+    void Redo() override { diagram.ExchangeExeOrder(i, j); }
+    bool IsValid([[maybe_unused]] bool redo) const override
+    {
+        const int size = static_cast<int>(diagram.exeOrder.size());
+        return i >= 0 && j >= 0 && i < size && j < size;
+    }
+    size_t GetMemory() const override { return sizeof(*this); }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("order");
+        record.Put(static_cast<int32_t>(i));
+        record.Put(static_cast<int32_t>(j));
+    }
+    static std::unique_ptr<CoreCommand> Read(CoreDiagram& diagram, RecoveryRecord& record)
+    {
+        const int i = record.Get<int32_t>();
+        const int j = record.Get<int32_t>();
+        return std::make_unique<OrderEdit>(diagram, i, j);
+    }
+};
+
+std::unique_ptr<CoreCommand> CoreDiagram::ReadCommand(const std::string& type, RecoveryRecord& record)
+{
+    std::unique_ptr<CoreCommand> command;
+    if (type == "move")
+    {
+        command = MoveEdit::Read(*this, record);
+    }
+    else if (type == "link")
+    {
+        command = LinkEdit::Read(*this, record);
+    }
+    else if (type == "nodes")
+    {
+        command = NodesEdit::Read(*this, record);
+    }
+    else if (type == "param")
+    {
+        command = ParamEdit::Read(*this, record);
+    }
+    else if (type == "rename")
+    {
+        command = RenameEdit::Read(*this, record);
+    }
+    else if (type == "toggle")
+    {
+        command = ToggleEdit::Read(*this, record);
+    }
+    else if (type == "order")
+    {
+        command = OrderEdit::Read(*this, record);
+    }
+    if (record.IsValid() == false)
+    {
+        return nullptr;
+    }
+    return command;
+}
+
+CoreDiagram::LinkRecord CoreDiagram::GetLinkRecord(const Link& link) const
+{
+    return LinkRecord{ link.inputNode->GetName(), link.inputPort->GetOrder(), link.outputNode->GetName(), link.outputPort->GetOrder() };
+}
+
+CoreDiagram::LinkRecord CoreDiagram::GetLinkRecord(const CoreNode* node, const CoreNodeInput& input) const
+{
+    return LinkRecord{ node->GetName(), input.GetOrder(), input.GetTargetNode()->GetName(), input.GetTargetNodeOutput()->GetOrder() };
+}
+
+bool CoreDiagram::FindLink(const LinkRecord& record, Link& link) const
+{
+    link.inputNode = FindNode(record.inputNode);
+    link.outputNode = FindNode(record.outputNode);
+    if (link.inputNode == nullptr || link.outputNode == nullptr ||
+        record.inputPort < 0 || record.inputPort >= link.inputNode->GetInputVec().size() ||
+        record.outputPort < 0 || record.outputPort >= link.outputNode->GetOutputVec().size())
+    {
+        return false;
+    }
+    link.inputPort = &(link.inputNode->GetInputVec()[record.inputPort]);
+    link.outputPort = &(link.outputNode->GetOutputVec()[record.outputPort]);
+    return true;
+}
+
+bool CoreDiagram::IsLinkValid(const LinkRecord& record, bool linked, const std::vector<std::string>& inserted) const
+{
+    // The nodes about to be inserted are not there yet, their inputs are free.
+    const bool inputInserted = std::find(inserted.begin(), inserted.end(), record.inputNode) != inserted.end();
+    const bool outputInserted = std::find(inserted.begin(), inserted.end(), record.outputNode) != inserted.end();
+    const CoreNode* inputNode = FindNode(record.inputNode);
+    const CoreNode* outputNode = FindNode(record.outputNode);
+    if (inputInserted == false && (inputNode == nullptr || record.inputPort < 0 || record.inputPort >= inputNode->GetInputVec().size()))
+    {
+        return false;
+    }
+    if (outputInserted == false && (outputNode == nullptr || record.outputPort < 0 || record.outputPort >= outputNode->GetOutputVec().size()))
+    {
+        return false;
+    }
+    if (inputInserted == true)
+    {
+        return linked == false;
+    }
+    const CoreNodeInput& input = inputNode->GetInputVec()[record.inputPort];
+    if (linked == false)
+    {
+        return input.GetTargetNode() == nullptr;
+    }
+    return outputInserted == false && input.GetTargetNodeOutput() == &outputNode->GetOutputVec()[record.outputPort];
+}
+
+bool CoreDiagram::HasNodes(const std::vector<std::string>& names) const
+{
+    for (const auto& name : names)
+    {
+        if (FindNode(name) == nullptr)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CoreDiagram::ConnectLink(const LinkRecord& record)
+{
+    Link link;
+    if (FindLink(record, link) == false || link.inputPort->GetTargetNode() != nullptr)
+    {
+        return; // Only for a node of a damaged journal that InsertNodes skipped, the edits check the others.
+    }
+    AddLink(link);
+}
+
+void CoreDiagram::DisconnectLink(const LinkRecord& record)
+{
+    Link link;
+    if (FindLink(record, link) == false)
+    {
+        return;
+    }
+    link.inputPort->BreakLink();
+    EraseLink(link.inputPort);
+}
+
+void CoreDiagram::Connect(const Link& link)
+{
+    auto edit = std::make_unique<LinkEdit>(*this, GetLinkRecord(link), true); // Before AddLink reorders.
+    AddLink(link);
+    journal.Record(std::move(edit));
+}
+
+void CoreDiagram::Disconnect(CoreNode* node, CoreNodeInput* input)
+{
+    journal.Record(std::make_unique<LinkEdit>(*this, GetLinkRecord(node, *input), false));
+    input->BreakLink();
+    EraseLink(input);
+}
+
+void CoreDiagram::DeleteNodes(const std::vector<CoreNode*>& nodes)
+{
+    auto edit = std::make_unique<NodesEdit>(*this, false);
+    for (const auto& node : nodes)
+    {
+        // Delete all input connections.
+        for (auto& input : node->GetInputVec())
+        {
+            if (input.GetTargetNode() != nullptr)
+            {
+                edit->AddLink(GetLinkRecord(node, input));
+                input.BreakLink();
+                EraseLink(&input);
+            }
+        }
+        // Delete all connections that are connected with outputs.
+        const auto consumers = GetConsumers(node);
+        for (const auto& consumer : consumers)
+        {
+            edit->AddLink(GetLinkRecord(consumer.node, *consumer.input));
+            consumer.input->BreakLink();
+            EraseLink(consumer.input);
+        }
+        // Check all output connections.
+        for (const auto& output : node->GetOutputVec())
+        {
+            IM_ASSERT(output.GetLinkNum() == 0);
+        }
+    }
+
+    // Delete nodes
+    edit->AddNodes(nodes);
+    journal.Record(std::move(edit));
+    RemoveNodes(nodes);
+}
+
+void CoreDiagram::RecordMove()
+{
+    const ImVec2 delta = iNode->GetRectNode().Min - dragOrigin;
+    if (delta.x == 0.0f && delta.y == 0.0f)
+    {
+        return;
+    }
+    std::vector<std::string> names;
+    if (iNode->GetFlagSet().HasFlag(NodeFlag::Selected) == false)
+    {
+        names.push_back(iNode->GetName());
+    }
+    else
+    {
+        for (const auto& node : coreNodeVec)
+        {
+            if (node->GetFlagSet().HasFlag(NodeFlag::Selected))
+            {
+                names.push_back(node->GetName());
+            }
+        }
+    }
+    journal.Record(std::make_unique<MoveEdit>(*this, std::move(names), delta));
+}
+
+void CoreDiagram::RecordAdd(CoreNode* node)
+{
+    auto edit = std::make_unique<NodesEdit>(*this, true);
+    edit->AddNodes({ node });
+    journal.Record(std::move(edit));
+}
+
+void CoreDiagram::RecordParam(CoreNode* node, int param, double before)
+{
+    journal.Record(std::make_unique<ParamEdit>(*this, node->GetName(), param, before, node->GetParams().at(param)->Get()));
+}
+
+void CoreDiagram::RecordRename(const std::string& before, const std::string& after)
+{
+    journal.Record(std::make_unique<RenameEdit>(*this, before, after));
+}
+
+void CoreDiagram::RecordToggle(const CoreNode* node, bool collapse)
+{
+    journal.Record(std::make_unique<ToggleEdit>(*this, node->GetName(), collapse));
+}
+
+void CoreDiagram::RecordOrder(int i, int j)
+{
+    journal.Record(std::make_unique<OrderEdit>(*this, i, j));
+}
+
+void CoreDiagram::ToggleCollapse(CoreNode* node)
+{
+    ImRect rNode = node->GetRectNode();
+    if (node->GetFlagSet().HasFlag(NodeFlag::Collapsed))
+    {
+        node->GetFlagSet().UnsetFlag(NodeFlag::Collapsed);
+        rNode.Max.y += node->GetBodyHeight();
+    }
+    else
+    {
+        node->GetFlagSet().SetFlag(NodeFlag::Collapsed);
+        rNode.Max.y -= node->GetBodyHeight();
+    }
+    node->SetRectNode(rNode);
+}
+
+void CoreDiagram::RemoveNodes(const std::vector<CoreNode*>& nodes)
+{
+    std::unordered_set<const CoreNode*> removed(nodes.begin(), nodes.end());
+    auto isRemoved = [&removed](const CoreNode* node) { return removed.count(node) != 0; };
+    for (const auto& node : nodes)
+    {
+        if (node == highlightedNode)
+        {
+            highlightedNode = nullptr;
+        }
+        if (node == hovNode)
+        {
+            hovNode = nullptr;
+        }
+        if (node == iNode)
+        {
+            iNode = nullptr;
+        }
+        spatialIndex.Remove(node);
+        nameIndex.erase(node->GetName());
+        routingDirty.erase(node);
+    }
+    exeOrder.erase(std::remove_if(exeOrder.begin(), exeOrder.end(), isRemoved), exeOrder.end());
+    coreNodeVec.erase(std::remove_if(coreNodeVec.begin(), coreNodeVec.end(), isRemoved), coreNodeVec.end());
+    visibleNodes.erase(std::remove_if(visibleNodes.begin(), visibleNodes.end(), isRemoved), visibleNodes.end());
+    for (const auto& node : nodes)
+    {
+        exeIndex.erase(node);
+        nodePool.Destroy(node);
+    }
+    IndexExeOrder();
+    IndexNodeOrder();
+}
+
+void CoreDiagram::InsertNodes(const std::string& nodeList, const std::vector<int>& nodeOrders, const std::vector<int>& exeOrders)
+{
+    pugi::xml_document doc;
+    doc.load_string(nodeList.c_str());
+    std::vector<std::pair<int, CoreNode*>> exePositions;
+    int k = 0;
+    for (const auto& element : doc.child("nodeList").children("node"))
+    {
+        if (k >= nodeOrders.size())
+        {
+            break;
+        }
+        CoreNode* node = CreateNode(nodePool, element.attribute("libName").as_string(), element.attribute("name").as_string());
+        if (node == nullptr)
+        {
+            k += 1;
+            continue;
+        }
+        node->Load(element);
+        node->GetFlagSet().UnsetFlag(NodeFlag::Visible | NodeFlag::Highlighted);
+        node->SetObserver(this);
+        coreNodeVec.insert(coreNodeVec.begin() + std::min(nodeOrders[k], static_cast<int>(coreNodeVec.size())), node);
+        exePositions.emplace_back(exeOrders[k], node);
+        spatialIndex.Insert(node, nodeOrders[k]);
+        nameIndex[node->GetName()] = node;
+        k += 1;
+    }
+
+    // Ascending, so each node goes back to where it was.
+    std::sort(exePositions.begin(), exePositions.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& [order, node] : exePositions)
+    {
+        exeOrder.insert(exeOrder.begin() + std::min(order, static_cast<int>(exeOrder.size())), node);
+    }
+    IndexExeOrder();
+    IndexNodeOrder();
+    routingDirtyAll = true;
+}
+
+void CoreDiagram::ResetInteraction()
+{
+    // Undo and redo may remove any node, drop the pointers of the current interaction.
+    state = State::Default;
+    mNodeDrag = false;
+    hovNode = nullptr;
+    iNode = nullptr;
+    iNodeInput = nullptr;
+    iNodeOutput = nullptr;
+    inputFreeLink = ImVec2();
+    outputFreeLink = ImVec2();
+    rectSelecting = ImRect();
+    editingName = false;
+}
+
+bool CoreDiagram::Undo()
+{
+    ResetInteraction();
+    return journal.Undo();
+}
+
+bool CoreDiagram::Redo()
+{
+    ResetInteraction();
+    return journal.Redo();
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Draw Cache                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreDrawCache.hpp"
+
+void CoreDrawCache::BeginFrame(float canvasScale)
+{
+    // Line widths, circle segments and glyphs depend on the zoom, only the scroll can be replayed.
+    if (canvasScale != scale)
+    {
+        items.clear();
+        scale = canvasScale;
+    }
+    frame += 1;
+    replayedNum = 0;
+    recordedNum = 0;
+}
+
+void CoreDrawCache::EndFrame()
+{
+    for (auto it = items.begin(); it != items.end();)
+    {
+        if (frame - it->second.frame > maxAge)
+        {
+            it = items.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void CoreDrawCache::Clear()
+{
+    items.clear();
+}
+
+bool CoreDrawCache::Replay(ImDrawList* drawList, const void* key, unsigned long long signature, ImVec2 offset)
+{
+    auto it = items.find(key);
+    if (it == items.end() || it->second.signature != signature)
+    {
+        return false;
+    }
+    Item& item = it->second;
+    item.frame = frame;
+    replayedNum += 1;
+    const int vtxNum = static_cast<int>(item.vtxVec.size());
+    const int idxNum = static_cast<int>(item.idxVec.size());
+    if (vtxNum == 0)
+    {
+        return true;
+    }
+    drawList->PrimReserve(idxNum, vtxNum); // May start a new command with a vertex offset.
+    const auto base = static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx);
+    const ImVec2 delta = offset - item.offset;
+    ImDrawVert* vtx = drawList->_VtxWritePtr;
+    for (const auto& v : item.vtxVec)
+    {
+        *vtx = v;
+        vtx->pos += delta;
+        vtx++;
+    }
+    ImDrawIdx* idx = drawList->_IdxWritePtr;
+    for (const auto& i : item.idxVec)
+    {
+        *idx = static_cast<ImDrawIdx>(base + i);
+        idx++;
+    }
+    drawList->_VtxWritePtr += vtxNum;
+    drawList->_IdxWritePtr += idxNum;
+    drawList->_VtxCurrentIdx += vtxNum;
+    return true;
+}
+
+void CoreDrawCache::BeginRecord(const ImDrawList* drawList, ImVec2 offset)
+{
+    vtxStart = drawList->VtxBuffer.Size;
+    idxStart = drawList->IdxBuffer.Size;
+    cmdNum = drawList->CmdBuffer.Size;
+    vtxOffset = drawList->_CmdHeader.VtxOffset;
+    vtxCurrentIdx = drawList->_VtxCurrentIdx;
+    recordOffset = offset;
+}
+
+void CoreDrawCache::EndRecord(const ImDrawList* drawList, const void* key, unsigned long long signature)
+{
+    recordedNum += 1;
+    if (drawList->CmdBuffer.Size != cmdNum || drawList->_CmdHeader.VtxOffset != vtxOffset)
+    {
+        // Split over commands (clip rect, texture or vertex offset change), not cached.
+        items.erase(key);
+        return;
+    }
+    Item& item = items[key];
+    item.signature = signature;
+    item.frame = frame;
+    item.offset = recordOffset;
+    item.vtxVec.assign(drawList->VtxBuffer.Data + vtxStart, drawList->VtxBuffer.Data + drawList->VtxBuffer.Size);
+    item.idxVec.resize(drawList->IdxBuffer.Size - idxStart);
+    for (size_t i = 0; i < item.idxVec.size(); i++)
+    {
+        item.idxVec[i] = static_cast<ImDrawIdx>(drawList->IdxBuffer.Data[idxStart + i] - vtxCurrentIdx);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Draw Cache                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREDRAWCACHE_HPP
+#define COREDRAWCACHE_HPP
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <vector>
+#include <unordered_map>
+
+// Retained vertices of the canvas items. An item is tessellated once into the draw list, copied out,
+// and replayed with the scroll as a translation until its signature or the zoom changes.
+class CoreDrawCache
+{
+private:
+    struct Item
+    {
+        std::vector<ImDrawVert> vtxVec;
+        std::vector<ImDrawIdx> idxVec;      // Relative to the first vertex of the item.
+        ImVec2 offset;                      // Canvas offset at the recording.
+        unsigned long long signature = 0;
+        unsigned int frame = 0;             // Last frame the item was drawn.
+    };
+    std::unordered_map<const void*, Item> items;
+    float scale = 0.0f;
+    unsigned int frame = 0;
+    const unsigned int maxAge = 120;        // Frames an unused item is kept.
+
+    // Recording
+    int vtxStart = 0;
+    int idxStart = 0;
+    int cmdNum = 0;
+    unsigned int vtxOffset = 0;
+    unsigned int vtxCurrentIdx = 0;
+    ImVec2 recordOffset;
+
+    // Statistics of the last frame.
+    int replayedNum = 0;
+    int recordedNum = 0;
+
+public:
+    CoreDrawCache() = default;
+    virtual ~CoreDrawCache() = default;
+    void BeginFrame(float canvasScale);     // Drops everything when the zoom changed.
+    void EndFrame();                        // Evicts the items that were not drawn for a while.
+    void Clear();
+
+    // Replays the item if it is cached with the same signature.
+    bool Replay(ImDrawList* drawList, const void* key, unsigned long long signature, ImVec2 offset);
+    void BeginRecord(const ImDrawList* drawList, ImVec2 offset);
+    void EndRecord(const ImDrawList* drawList, const void* key, unsigned long long signature);
+
+    int GetReplayedNum() const { return replayedNum; }
+    int GetRecordedNum() const { return recordedNum; }
+    size_t GetItemNum() const { return items.size(); }
+};
+
+// FNV-1a, for the item signatures.
+inline unsigned long long HashDraw(unsigned long long hash, const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template<typename T>
+inline unsigned long long HashDraw(unsigned long long hash, const T& value)
+{
+    return HashDraw(hash, &value, sizeof(T));
+}
+
+const unsigned long long hashDrawSeed = 14695981039346656037ULL;
+
+#endif /* COREDRAWCACHE_HPP */
\ No newline at end of file
@@ -0,0 +1,30 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Factory                                                                         *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreFactory.hpp"
+#include "GainNode.hpp"
+#include "TestNode.hpp"
+#include "IntegratorNode.hpp"
+
+CoreNode* CreateNode(CoreNodePool& pool, std::string_view libName, const std::string& uniqueName)
+{
+    if (libName == "Gain")
+    {
+        return pool.Create<GainNode>(uniqueName);
+    }
+    if (libName == "Test")
+    {
+        return pool.Create<TestNode>(uniqueName);
+    }
+    if (libName == "Integrator")
+    {
+        return pool.Create<IntegratorNode>(uniqueName);
+    }
+    return nullptr;
+}
\ No newline at end of file
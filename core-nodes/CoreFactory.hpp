@@ -0,0 +1,19 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Factory                                                                         *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREFACTORY_HPP
+#define COREFACTORY_HPP
+
+#include "CoreNodePool.hpp"
+#include <string_view>
+
+// Creates a node of the library by its name in the pool. Returns nullptr for an unknown name.
+CoreNode* CreateNode(CoreNodePool& pool, std::string_view libName, const std::string& uniqueName);
+
+#endif /* COREFACTORY_HPP */
\ No newline at end of file
@@ -0,0 +1,738 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Graph                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreGraph.hpp"
+
+static const size_t parallelLoadMin = 256; // Smaller diagrams load on the calling thread.
+
+CoreGraph::~CoreGraph()
+{
+    nodePool.Clear();
+}
+
+void CoreGraph::Load(const pugi::xml_node& xmlNode)
+{
+    IsProjectV1(xmlNode) == true ? LoadGraphV1(xmlNode.child("diagram")) : LoadGraph(xmlNode.child("diagram"));
+}
+
+void CoreGraph::Save(CoreBinaryWriter& writer) const
+{
+    SaveGraph(writer);
+}
+
+void CoreGraph::Load(const CoreBinaryReader& reader)
+{
+    LoadGraph(reader);
+}
+
+void CoreGraph::LoadGraph(const pugi::xml_node& node)
+{
+    std::vector<CoreNode*> nodes;
+    std::vector<pugi::xml_node> elements;
+    for (const auto& element : node.child("nodeList").children("node"))
+    {
+        const std::string libName = element.attribute("libName").as_string();
+        CoreNode* coreNode = CreateNode(nodePool, libName, element.attribute("name").as_string());
+        if (coreNode == nullptr)
+        {
+            Notifier::Add(Notif(Notif::Type::WARNING, "Node skipped", "Unknown library node " + libName + ".", 5.0f));
+            continue;
+        }
+        nodes.push_back(coreNode);
+        elements.push_back(element);
+    }
+    LoadNodes(nodes, [&](size_t i) { nodes[i]->Load(elements[i]); });
+    routingDirtyAll = true;
+    for (const auto& element : node.child("linkList").children("link"))
+    {
+        Link link{};
+        link.inputNode = FindNode(element.attribute("inputNode").as_string());
+        link.outputNode = FindNode(element.attribute("outputNode").as_string());
+        if (BindLink(link, element.attribute("inputPort").as_int(-1), element.attribute("outputPort").as_int(-1)) == true)
+        {
+            link.outputPort->IncreaseLinkNum();
+        }
+    }
+    for (const auto& element : node.child("exeList").children("node"))
+    {
+        CoreNode* nodeElement = FindNode(element.attribute("name").as_string());
+        if (nodeElement != nullptr)
+        {
+            exeOrder.push_back(nodeElement);
+        }
+    }
+    IndexExeOrder();
+    if (IsExeOrderValid() == false && SortExeOrder() == true)
+    {
+        Notifier::Add(Notif(Notif::Type::INFO, "Execution order updated"));
+    }
+}
+
+void CoreGraph::LoadGraphV1(const pugi::xml_node& node)
+{
+    std::vector<CoreNode*> nodes;
+    std::vector<pugi::xml_node> elements;
+    for (const auto& element : node.child("nodeList").children("node"))
+    {
+        const std::string libName = LoadString(element, "libName");
+        CoreNode* coreNode = CreateNode(nodePool, libName, LoadString(element, "name"));
+        if (coreNode == nullptr)
+        {
+            Notifier::Add(Notif(Notif::Type::WARNING, "Node skipped", "Unknown library node " + libName + ".", 5.0f));
+            continue;
+        }
+        nodes.push_back(coreNode);
+        elements.push_back(element);
+    }
+    LoadNodes(nodes, [&](size_t i) { nodes[i]->LoadV1(elements[i]); }); // Add nodes without building.
+    routingDirtyAll = true;
+    for (const auto& element : node.child("linkList").children("link"))
+    {
+        // Match pointers
+        Link link;
+        link.LoadV1(element);
+        link.inputNode = FindNode(LoadString(element, "inputNode"));
+        link.outputNode = FindNode(LoadString(element, "outputNode"));
+        BindLink(link, LoadInt(element, "inputPort"), LoadInt(element, "outputPort"));
+    }
+    for (const auto& element : node.child("exeList").children("node"))
+    {
+        CoreNode* nodeElement = FindNode(element.attribute("name").as_string());
+        if (nodeElement != nullptr)
+        {
+            exeOrder.push_back(nodeElement);
+        }
+    }
+    IndexExeOrder();
+    if (IsExeOrderValid() == false && SortExeOrder() == true)
+    {
+        Notifier::Add(Notif(Notif::Type::INFO, "Execution order updated"));
+    }
+}
+
+void CoreGraph::LoadNodes(const std::vector<CoreNode*>& nodes, const std::function<void(size_t)>& load)
+{
+    // The nodes are allocated by the caller, a load touches only its own node. The observer and the
+    // indexes are set here afterwards, on the calling thread.
+    if (nodes.size() < parallelLoadMin)
+    {
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            load(i);
+        }
+    }
+    else
+    {
+        CorePool pool;
+        pool.ParallelFor(static_cast<long long>(nodes.size()), [&load](long long i, int) { load(static_cast<size_t>(i)); });
+    }
+    for (const auto& node : nodes)
+    {
+        node->SetObserver(this);
+        coreNodeVec.push_back(node);
+        IndexNode(node);
+    }
+}
+
+bool CoreGraph::BindLink(Link& link, int inputPortOrder, int outputPortOrder)
+{
+    if (link.inputNode == nullptr || link.outputNode == nullptr ||
+        inputPortOrder < 0 || inputPortOrder >= link.inputNode->GetInputVec().size() ||
+        outputPortOrder < 0 || outputPortOrder >= link.outputNode->GetOutputVec().size())
+    {
+        Notifier::Add(Notif(Notif::Type::WARNING, "Link skipped", "A link refers to a missing node or port.", 5.0f));
+        return false;
+    }
+    link.inputPort = &(link.inputNode->GetInputVec()[inputPortOrder]);
+    link.outputPort = &(link.outputNode->GetOutputVec()[outputPortOrder]);
+    link.inputPort->SetTargetNode(link.outputNode);
+    link.inputPort->SetTargetNodeOutput(link.outputPort);
+    linkIndex[link.inputPort] = static_cast<int>(linkVec.size());
+    linkVec.push_back(link);
+    AddConsumer(linkVec.back());
+    return true;
+}
+
+void CoreGraph::SaveGraph(CoreBinaryWriter& writer) const
+{
+    // Records refer to nodes by their position in the node table, which is the node vector order.
+    for (const auto& element : coreNodeVec)
+    {
+        element->Save(writer);
+    }
+    for (const auto& i : GetLinkOrder())
+    {
+        const Link& element = linkVec[i];
+        writer.AddLink(element.Save(nodeIndex.at(element.inputNode), nodeIndex.at(element.outputNode)));
+    }
+    for (const auto& element : exeOrder)
+    {
+        writer.AddExe(nodeIndex.at(element));
+    }
+}
+
+void CoreGraph::LoadGraph(const CoreBinaryReader& reader)
+{
+    std::vector<CoreNode*> tableNodes(reader.GetCount(BinaryTable::Nodes), nullptr); // Node of each record.
+    std::vector<CoreNode*> nodes;
+    std::vector<size_t> records;
+    for (size_t i = 0; i < tableNodes.size(); i++)
+    {
+        const BinaryNode record = reader.GetNode(i);
+        CoreNode* node = CreateNode(nodePool, reader.GetString(record.libName), reader.GetString(record.name));
+        if (node == nullptr)
+        {
+            Notifier::Add(Notif(Notif::Type::WARNING, "Node skipped", "Unknown library node " + reader.GetString(record.libName) + ".", 5.0f));
+            continue;
+        }
+        tableNodes[i] = node;
+        nodes.push_back(node);
+        records.push_back(i);
+    }
+    LoadNodes(nodes, [&](size_t i) { nodes[i]->Load(reader, reader.GetNode(records[i])); }); // Add nodes without building.
+    routingDirtyAll = true;
+    for (size_t i = 0; i < reader.GetCount(BinaryTable::Links); i++)
+    {
+        const BinaryLink record = reader.GetLink(i);
+        Link link;
+        link.Load(record);
+        link.inputNode = tableNodes[record.inputNode];
+        link.outputNode = tableNodes[record.outputNode];
+        BindLink(link, record.inputPort, record.outputPort);
+    }
+    for (size_t i = 0; i < reader.GetCount(BinaryTable::ExeOrder); i++)
+    {
+        CoreNode* nodeElement = tableNodes[reader.GetExe(i)];
+        if (nodeElement != nullptr)
+        {
+            exeOrder.push_back(nodeElement);
+        }
+    }
+    IndexExeOrder();
+    if (IsExeOrderValid() == false && SortExeOrder() == true)
+    {
+        Notifier::Add(Notif(Notif::Type::INFO, "Execution order updated"));
+    }
+}
+
+void CoreGraph::IndexNode(CoreNode* node)
+{
+    const int i = static_cast<int>(coreNodeVec.size()) - 1;
+    spatialIndex.Insert(node, i);
+    nameIndex[node->GetName()] = node;
+    boundsTable.Push(node->GetRectBounds());
+    nodeTable.Push(node->GetRectNode());
+    nodeIndex[node] = i;
+}
+
+void CoreGraph::IndexNodeOrder()
+{
+    spatialIndex.SetOrder(coreNodeVec);
+    boundsTable.Clear();
+    nodeTable.Clear();
+    nodeIndex.clear();
+    for (int i = 0; i < coreNodeVec.size(); i++)
+    {
+        boundsTable.Push(coreNodeVec[i]->GetRectBounds());
+        nodeTable.Push(coreNodeVec[i]->GetRectNode());
+        nodeIndex[coreNodeVec[i]] = i;
+    }
+}
+
+void CoreGraph::AddNode(CoreNode* node)
+{
+    coreNodeVec.push_back(node);
+    node->SetObserver(this);
+    IndexNode(node);
+    exeIndex[node] = static_cast<int>(exeOrder.size());
+    exeOrder.push_back(node);
+}
+
+void CoreGraph::AddLink(const Link& link)
+{
+    link.inputPort->SetTargetNode(link.outputNode);
+    link.inputPort->SetTargetNodeOutput(link.outputPort);
+    link.outputPort->IncreaseLinkNum();
+    linkIndex[link.inputPort] = static_cast<int>(linkVec.size());
+    linkVec.push_back(link);
+    AddConsumer(link);
+    routingDirty.insert(link.inputNode);
+    routingDirty.insert(link.outputNode);
+    if (IsOrdered(link.inputNode, *link.inputPort) == true)
+    {
+        UpdateExeOrder(link.outputNode, link.inputNode);
+    }
+}
+
+bool CoreGraph::SwapExeOrder(int i, int j)
+{
+    // Only allow the swap if the upper node does not feed the lower one.
+    if (HasDirectLink(exeOrder.at(std::min(i, j)), exeOrder.at(std::max(i, j))) == true)
+    {
+        return false;
+    }
+    ExchangeExeOrder(i, j);
+    return true;
+}
+
+void CoreGraph::ExchangeExeOrder(int i, int j)
+{
+    std::swap(exeOrder.at(i), exeOrder.at(j));
+    exeIndex[exeOrder.at(i)] = i;
+    exeIndex[exeOrder.at(j)] = j;
+}
+
+bool CoreGraph::Compile(CoreProgram& program) const
+{
+    if (algebraicLoop == true)
+    {
+        Notifier::Add(Notif(Notif::Type::ERROR, "Compile failed!", "The diagram has an algebraic loop.", 5.0f));
+        return false;
+    }
+    if (program.Compile(exeOrder) == false)
+    {
+        Notifier::Add(Notif(Notif::Type::ERROR, "Compile failed!", program.GetError(), 5.0f));
+        return false;
+    }
+    return true;
+}
+
+void CoreGraph::IndexExeOrder()
+{
+    exeIndex.clear();
+    for (int i = 0; i < exeOrder.size(); i++)
+    {
+        exeIndex[exeOrder[i]] = i;
+    }
+}
+
+bool CoreGraph::IsExeOrderValid() const
+{
+    for (const auto& link : linkVec)
+    {
+        if (IsOrdered(link.inputNode, *link.inputPort) == false)
+        {
+            continue;
+        }
+        auto itOutput = exeIndex.find(link.outputNode);
+        auto itInput = exeIndex.find(link.inputNode);
+        if (itOutput == exeIndex.end() || itInput == exeIndex.end() || itOutput->second > itInput->second)
+        {
+            return false;
+        }
+    }
+    return exeOrder.size() == coreNodeVec.size();
+}
+
+bool CoreGraph::SortExeOrder()
+{
+    // Nodes missing from the order are appended.
+    IndexExeOrder();
+    for (const auto& node : coreNodeVec)
+    {
+        if (exeIndex.count(node) == 0)
+        {
+            exeIndex[node] = static_cast<int>(exeOrder.size());
+            exeOrder.push_back(node);
+        }
+    }
+
+    // Kahn's algorithm. Ready nodes are taken in their current order to keep the user's order where possible.
+    std::unordered_map<const CoreNode*, int> inDegree;
+    std::unordered_map<const CoreNode*, std::vector<CoreNode*>> successors;
+    for (const auto& link : linkVec)
+    {
+        if (IsOrdered(link.inputNode, *link.inputPort) == true)
+        {
+            inDegree[link.inputNode] += 1;
+            successors[link.outputNode].push_back(link.inputNode);
+        }
+    }
+    std::priority_queue<int, std::vector<int>, std::greater<int>> ready;
+    for (int i = 0; i < exeOrder.size(); i++)
+    {
+        if (inDegree[exeOrder[i]] == 0)
+        {
+            ready.push(i);
+        }
+    }
+    std::vector<CoreNode*> sorted;
+    sorted.reserve(exeOrder.size());
+    while (ready.empty() == false)
+    {
+        CoreNode* node = exeOrder[ready.top()];
+        ready.pop();
+        sorted.push_back(node);
+        for (const auto& next : successors[node])
+        {
+            if (--inDegree[next] == 0)
+            {
+                ready.push(exeIndex.at(next));
+            }
+        }
+    }
+
+    // Remaining nodes are on, or downstream of, an algebraic loop.
+    algebraicLoop = sorted.size() != exeOrder.size();
+    if (algebraicLoop == true)
+    {
+        std::string names;
+        for (const auto& node : exeOrder)
+        {
+            if (inDegree[node] > 0)
+            {
+                sorted.push_back(node);
+                names += names.empty() ? node->GetName() : ", " + node->GetName();
+            }
+        }
+        Notifier::Add(Notif(Notif::Type::WARNING, "Algebraic loop!", "Nodes in or after the loop: " + names, 5.0f));
+    }
+    exeOrder = sorted;
+    IndexExeOrder();
+    return algebraicLoop == false;
+}
+
+void CoreGraph::UpdateExeOrder(CoreNode* outputNode, CoreNode* inputNode)
+{
+    // Incremental topological ordering (Pearce-Kelly). Only nodes between the two ends of the new link are visited.
+    const int lowerBound = exeIndex.at(inputNode);
+    const int upperBound = exeIndex.at(outputNode);
+    if (upperBound < lowerBound)
+    {
+        return; // Order is still valid.
+    }
+
+    // Forward search from the input node.
+    std::vector<CoreNode*> deltaF;
+    std::unordered_map<const CoreNode*, CoreNode*> parent{ { inputNode, nullptr } };
+    std::vector<CoreNode*> stack{ inputNode };
+    while (stack.empty() == false)
+    {
+        CoreNode* node = stack.back();
+        stack.pop_back();
+        deltaF.push_back(node);
+        for (const auto& next : GetSuccessors(node))
+        {
+            if (next == outputNode)
+            {
+                std::string names = outputNode->GetName();
+                std::vector<CoreNode*> path;
+                for (CoreNode* n = node; n != nullptr; n = parent.at(n))
+                {
+                    path.push_back(n);
+                }
+                for (auto it = path.rbegin(); it != path.rend(); ++it)
+                {
+                    names += " > " + (*it)->GetName();
+                }
+                names += " > " + outputNode->GetName();
+                Notifier::Add(Notif(Notif::Type::WARNING, "Algebraic loop!", names, 5.0f));
+                algebraicLoop = true;
+                return;
+            }
+            if (exeIndex.at(next) < upperBound && parent.count(next) == 0)
+            {
+                parent[next] = node;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    // Backward search from the output node.
+    std::vector<CoreNode*> deltaB;
+    std::unordered_map<const CoreNode*, bool> visited{ { outputNode, true } };
+    stack.push_back(outputNode);
+    while (stack.empty() == false)
+    {
+        CoreNode* node = stack.back();
+        stack.pop_back();
+        deltaB.push_back(node);
+        for (const auto& prev : GetPredecessors(node))
+        {
+            if (exeIndex.at(prev) > lowerBound && visited.count(prev) == 0)
+            {
+                visited[prev] = true;
+                stack.push_back(prev);
+            }
+        }
+    }
+
+    // Reuse the positions of the affected nodes: upstream of the output first, then downstream of the input.
+    auto byIndex = [this](const CoreNode* a, const CoreNode* b) { return exeIndex.at(a) < exeIndex.at(b); };
+    std::sort(deltaB.begin(), deltaB.end(), byIndex);
+    std::sort(deltaF.begin(), deltaF.end(), byIndex);
+    std::vector<int> slots;
+    slots.reserve(deltaB.size() + deltaF.size());
+    for (const auto& node : deltaB)
+    {
+        slots.push_back(exeIndex.at(node));
+    }
+    for (const auto& node : deltaF)
+    {
+        slots.push_back(exeIndex.at(node));
+    }
+    std::sort(slots.begin(), slots.end());
+    deltaB.insert(deltaB.end(), deltaF.begin(), deltaF.end());
+    for (int i = 0; i < slots.size(); i++)
+    {
+        exeOrder[slots[i]] = deltaB[i];
+        exeIndex[deltaB[i]] = slots[i];
+    }
+}
+
+bool CoreGraph::IsOrdered(const CoreNode* node, const CoreNodeInput& input)
+{
+    // Nodes with an initial condition port hold states, their inputs do not feed through. The initial
+    // condition is read by init, in execution order, so its source must run first.
+    return input.GetType() == PortType::Ic || node->HasIcPort() == false;
+}
+
+std::vector<CoreNode*> CoreGraph::GetSuccessors(const CoreNode* node) const
+{
+    std::vector<CoreNode*> vec;
+    for (const auto& consumer : GetConsumers(node))
+    {
+        if (IsOrdered(consumer.node, *consumer.input) == true)
+        {
+            vec.push_back(consumer.node);
+        }
+    }
+    return vec;
+}
+
+std::vector<CoreNode*> CoreGraph::GetPredecessors(const CoreNode* node) const
+{
+    std::vector<CoreNode*> vec;
+    for (const auto& input : node->GetInputVec())
+    {
+        if (input.GetTargetNode() != nullptr && IsOrdered(node, input) == true)
+        {
+            vec.push_back(input.GetTargetNode());
+        }
+    }
+    return vec;
+}
+
+bool CoreGraph::HasDirectLink(const CoreNode* outputNode, const CoreNode* inputNode) const
+{
+    for (const auto& input : inputNode->GetInputVec())
+    {
+        if (input.GetTargetNode() == outputNode && IsOrdered(inputNode, input) == true)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CoreGraph::AddConsumer(const Link& link)
+{
+    outputConsumers[link.outputPort].push_back(Consumer{ link.inputNode, link.inputPort });
+    nodeConsumers[link.outputNode].push_back(Consumer{ link.inputNode, link.inputPort });
+}
+
+void CoreGraph::EraseConsumer(const Link& link)
+{
+    auto erase = [&link](std::vector<Consumer>& vec)
+    {
+        auto it = std::find_if(vec.begin(), vec.end(), [&link](const Consumer& c) { return c.input == link.inputPort; });
+        if (it != vec.end())
+        {
+            vec.erase(it);
+        }
+    };
+    auto itOutput = outputConsumers.find(link.outputPort);
+    if (itOutput != outputConsumers.end())
+    {
+        erase(itOutput->second);
+        if (itOutput->second.empty() == true)
+        {
+            outputConsumers.erase(itOutput);
+        }
+    }
+    auto itNode = nodeConsumers.find(link.outputNode);
+    if (itNode != nodeConsumers.end())
+    {
+        erase(itNode->second);
+        if (itNode->second.empty() == true)
+        {
+            nodeConsumers.erase(itNode);
+        }
+    }
+}
+
+const std::vector<CoreGraph::Consumer>& CoreGraph::GetConsumers(const CoreNodeOutput* output) const
+{
+    static const std::vector<Consumer> none;
+    auto it = outputConsumers.find(output);
+    return it == outputConsumers.end() ? none : it->second;
+}
+
+const std::vector<CoreGraph::Consumer>& CoreGraph::GetConsumers(const CoreNode* node) const
+{
+    static const std::vector<Consumer> none;
+    auto it = nodeConsumers.find(node);
+    return it == nodeConsumers.end() ? none : it->second;
+}
+
+std::string CoreGraph::CreateUniqueName(const std::string& libName)
+{
+    // The counter only grows, so dropping many nodes of a kind does not rescan the taken names.
+    unsigned int& i = nameCounter[libName];
+    std::string name = i == 0 ? libName : libName + std::to_string(i);
+    while (nameIndex.find(name) != nameIndex.end())
+    {
+        i += 1;
+        name = libName + std::to_string(i);
+    }
+    return name;
+}
+
+void CoreGraph::RenameNode(CoreNode* node, const std::string& newName)
+{
+    nameIndex.erase(node->GetName());
+    node->SetName(newName);
+    nameIndex[node->GetName()] = node;
+    routingDirty.insert(node); // The name orders its links in the routing.
+}
+
+CoreNode* CoreGraph::FindNode(const std::string& name) const
+{
+    auto it = nameIndex.find(name);
+    return it == nameIndex.end() ? nullptr : it->second;
+}
+
+void CoreGraph::EraseLink(const CoreNodeInput* input)
+{
+    auto it = linkIndex.find(input);
+    if (it == linkIndex.end())
+    {
+        return;
+    }
+    const int i = it->second;
+    linkIndex.erase(it);
+    routingDirty.insert(linkVec[i].inputNode);
+    routingDirty.insert(linkVec[i].outputNode);
+    EraseConsumer(linkVec[i]);
+    if (i != linkVec.size() - 1)
+    {
+        linkVec[i] = linkVec.back();
+        linkIndex[linkVec[i].inputPort] = i;
+    }
+    linkVec.pop_back();
+    if (algebraicLoop == true) // Removing a link never breaks the order, but it may break the loop.
+    {
+        SortExeOrder();
+    }
+}
+
+void CoreGraph::NodeMoved(CoreNode* node)
+{
+    spatialIndex.Update(node);
+    auto it = nodeIndex.find(node);
+    if (it != nodeIndex.end())
+    {
+        boundsTable.Set(it->second, node->GetRectBounds());
+        nodeTable.Set(it->second, node->GetRectNode());
+    }
+    routingDirty.insert(node);
+}
+
+std::vector<int> CoreGraph::GetLinkOrder() const
+{
+    std::vector<int> order;
+    order.reserve(linkVec.size());
+    for (const auto& node : coreNodeVec)
+    {
+        for (const auto& input : node->GetInputVec())
+        {
+            auto it = linkIndex.find(&input);
+            if (it != linkIndex.end())
+            {
+                order.push_back(it->second);
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<int> CoreGraph::GetRoutingAffectedLinks()
+{
+    std::vector<int> affected;
+    if (routingDirtyAll == true)
+    {
+        affected.reserve(linkVec.size());
+        for (int i = 0; i < linkVec.size(); i++)
+        {
+            affected.push_back(i);
+        }
+    }
+    else if (routingDirty.empty() == false)
+    {
+        // Links share separation slots with the other links of their input node and of their output node,
+        // so a change spreads over the links connected through those shared nodes. The links into a node are
+        // found through its input ports, the links out of it through its consumers.
+        std::unordered_set<int> marked;
+        std::unordered_set<const CoreNode*> inputDone;
+        std::unordered_set<const CoreNode*> outputDone;
+        std::vector<std::pair<const CoreNode*, bool>> stack; // Node, is input side.
+        auto mark = [&](const CoreNodeInput* input)
+        {
+            auto it = linkIndex.find(input);
+            if (it != linkIndex.end() && marked.insert(it->second).second == true)
+            {
+                affected.push_back(it->second);
+                stack.emplace_back(linkVec[it->second].inputNode, true);
+                stack.emplace_back(linkVec[it->second].outputNode, false);
+            }
+        };
+        for (const auto& node : routingDirty)
+        {
+            stack.emplace_back(node, true);
+            stack.emplace_back(node, false);
+        }
+        while (stack.empty() == false)
+        {
+            auto [node, inputSide] = stack.back();
+            stack.pop_back();
+            if ((inputSide ? inputDone : outputDone).insert(node).second == false)
+            {
+                continue;
+            }
+            if (inputSide == true)
+            {
+                for (const auto& input : node->GetInputVec())
+                {
+                    if (input.GetTargetNode() != nullptr)
+                    {
+                        mark(&input);
+                    }
+                }
+            }
+            else
+            {
+                for (const auto& consumer : GetConsumers(node))
+                {
+                    mark(consumer.input);
+                }
+            }
+        }
+    }
+    // The slot search depends on the order. Names are unique and kept by undo, redo and save, so the
+    // same links are routed the same way whichever node was last brought to front.
+    std::sort(affected.begin(), affected.end(), [this](int i, int j)
+    {
+        const std::string& nodeI = linkVec[i].inputNode->GetName();
+        const std::string& nodeJ = linkVec[j].inputNode->GetName();
+        return nodeI != nodeJ ? nodeI < nodeJ : linkVec[i].inputPort->GetOrder() < linkVec[j].inputPort->GetOrder();
+    });
+    routingDirty.clear();
+    routingDirtyAll = false;
+    return affected;
+}
\ No newline at end of file
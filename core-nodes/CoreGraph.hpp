@@ -0,0 +1,174 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Graph                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREGRAPH_HPP
+#define COREGRAPH_HPP
+
+#include "CoreFactory.hpp"
+#include "CoreSpatialIndex.hpp"
+#include "CoreRectTable.hpp"
+#include "CorePool.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <queue>
+
+// Nodes, links and the execution order of a diagram. Has no dependency on the ImGui context,
+// the editor and the batch runner are built on top of it.
+class CoreGraph : public NodeObserver
+{
+protected:
+    CoreNodePool nodePool; // Owns the nodes, declared first so it outlives the pointers below.
+    std::vector<CoreNode*> coreNodeVec;
+    std::vector<CoreNode*> exeOrder; // Execution order.
+    CoreSpatialIndex spatialIndex;
+    CoreRectTable boundsTable;                          // GetRectBounds of each node, in node vector order.
+    CoreRectTable nodeTable;                            // GetRectNode of each node, in node vector order.
+    std::unordered_map<const CoreNode*, int> nodeIndex; // Position of each node in the node vector.
+    void IndexNodeOrder();                              // After coreNodeVec is reordered.
+    void IndexNode(CoreNode* node);                     // After a node is appended to coreNodeVec.
+    std::unordered_map<std::string, CoreNode*> nameIndex;        // Node of each name.
+    std::unordered_map<std::string, unsigned int> nameCounter;   // Next suffix tried for each library name.
+    std::string CreateUniqueName(const std::string& libName);
+    void RenameNode(CoreNode* node, const std::string& newName);
+    void AddNode(CoreNode* node);
+    void LoadGraph(const pugi::xml_node& node);
+    void LoadGraphV1(const pugi::xml_node& node);
+    void LoadNodes(const std::vector<CoreNode*>& nodes, const std::function<void(size_t)>& load); // Then adds them.
+    void SaveGraph(CoreBinaryWriter& writer) const;
+    void LoadGraph(const CoreBinaryReader& reader);
+
+    // Execution order
+    std::unordered_map<const CoreNode*, int> exeIndex; // Position of each node in the execution order.
+    bool algebraicLoop = false;
+    void IndexExeOrder();
+    bool IsExeOrderValid() const;
+    bool SortExeOrder();
+    void UpdateExeOrder(CoreNode* outputNode, CoreNode* inputNode);
+    std::vector<CoreNode*> GetSuccessors(const CoreNode* node) const;
+    std::vector<CoreNode*> GetPredecessors(const CoreNode* node) const;
+    bool HasDirectLink(const CoreNode* outputNode, const CoreNode* inputNode) const;
+    static bool IsOrdered(const CoreNode* node, const CoreNodeInput& input); // The link into the input constrains the order.
+    bool SwapExeOrder(int i, int j);
+    void ExchangeExeOrder(int i, int j);    // Without the link check of SwapExeOrder.
+
+    // Network
+    enum class LinkType;
+    struct Link
+    {
+        CoreNode* inputNode;
+        CoreNode* outputNode;
+        CoreNodeInput* inputPort;
+        CoreNodeOutput* outputPort;
+        LinkType type;
+        ImColor color;
+        float thickness;
+        float xSepIn;
+        float xSepOut;
+        float ykSep = 0;
+        void LoadV1(const pugi::xml_node& xmlNode)
+        {
+            type = (LinkType)LoadInt(xmlNode, "type");
+            color = LoadImColor(xmlNode, "color");
+            thickness = LoadFloat(xmlNode, "thickness");
+            xSepIn = LoadFloat(xmlNode, "xSepIn");
+            xSepOut = LoadFloat(xmlNode, "xSepOut");
+            ykSep = LoadFloat(xmlNode, "ykSep");
+        }
+        BinaryLink Save(uint32_t inputNodeIndex, uint32_t outputNodeIndex) const
+        {
+            BinaryLink record;
+            record.inputNode = inputNodeIndex;
+            record.outputNode = outputNodeIndex;
+            record.inputPort = inputPort->GetOrder();
+            record.outputPort = outputPort->GetOrder();
+            record.type = (int)type;
+            record.color = ToBinary(color);
+            record.thickness = thickness;
+            record.xSepIn = xSepIn;
+            record.xSepOut = xSepOut;
+            record.ykSep = ykSep;
+            return record;
+        }
+        void Load(const BinaryLink& record)
+        {
+            type = (LinkType)record.type;
+            color = FromBinary(record.color);
+            thickness = record.thickness;
+            xSepIn = record.xSepIn;
+            xSepOut = record.xSepOut;
+            ykSep = record.ykSep;
+        }
+    };
+    std::vector<Link> linkVec;
+    std::unordered_map<const CoreNodeInput*, int> linkIndex; // Position of the link into each input.
+    void AddLink(const Link& link);
+    void EraseLink(const CoreNodeInput* input);                 // Moves the last link into the slot.
+    std::vector<int> GetLinkOrder() const;                      // Links by input node, then input port.
+    bool BindLink(Link& link, int inputPortOrder, int outputPortOrder); // On load, false for a missing node or port.
+
+    // Adjacency in the order the links were added, kept by AddLink and EraseLink.
+    struct Consumer
+    {
+        CoreNode* node;
+        CoreNodeInput* input;
+    };
+    std::unordered_map<const CoreNodeOutput*, std::vector<Consumer>> outputConsumers; // Inputs fed by each output.
+    std::unordered_map<const CoreNode*, std::vector<Consumer>> nodeConsumers;        // Inputs fed by any output of each node.
+    void AddConsumer(const Link& link);
+    void EraseConsumer(const Link& link);
+    const std::vector<Consumer>& GetConsumers(const CoreNodeOutput* output) const;
+    const std::vector<Consumer>& GetConsumers(const CoreNode* node) const;
+
+    // Link routing
+    std::unordered_set<const CoreNode*> routingDirty; // Moved, inverted, collapsed or relinked since the last routing.
+    bool routingDirtyAll = true;
+    std::vector<int> GetRoutingAffectedLinks(); // By input node name, then input port, an order the z-order does not change.
+    enum class LinkType
+    {
+        NONE,
+        // BINV: both nodes inverted.
+        BINV_LEFT,
+        BINV_RIGHT_OVER,
+        BINV_RIGHT_UNDER,
+        BINV_RIGHT_MID,
+        // IINV: only input node inverted.
+        IINV_RIGHT_OVER,
+        IINV_LEFT_OVER,
+        IINV_RIGHT_UNDER,
+        IINV_LEFT_UNDER,
+        IINV_MID,
+        // OINV: only output node inverted.
+        OINV_RIGHT_OVER,
+        OINV_LEFT_OVER,
+        OINV_RIGHT_UNDER,
+        OINV_LEFT_UNDER,
+        OINV_MID,
+        // NINV: No Inversion. Location of input node wrt output node.
+        NINV_RIGHT,
+        NINV_LEFT_OVER,
+        NINV_LEFT_UNDER,
+        NINV_LEFT_MID
+    };
+
+public:
+    CoreGraph() = default;
+    ~CoreGraph() override;
+    virtual void Load(const pugi::xml_node& xmlNode);
+    virtual void Save(CoreBinaryWriter& writer) const;
+    virtual void Load(const CoreBinaryReader& reader);
+    bool Compile(CoreProgram& program) const;
+    void NodeMoved(CoreNode* node) override;
+    const std::vector<CoreNode*>& GetNodeVec() const { return coreNodeVec; }
+    const std::vector<CoreNode*>& GetExeOrder() const { return exeOrder; }
+    CoreNode* GetNode(NodeHandle handle) const { return nodePool.Get(handle); }
+    CoreNode* FindNode(const std::string& name) const;
+};
+
+#endif /* COREGRAPH_HPP */
\ No newline at end of file
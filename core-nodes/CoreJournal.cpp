@@ -0,0 +1,119 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Journal                                                                         *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreJournal.hpp"
+#include <algorithm>
+
+void CoreJournal::Record(std::unique_ptr<CoreCommand> command)
+{
+    memory += command->GetMemory();
+    if (observer != nullptr)
+    {
+        observer->CommandRecorded(*command);
+    }
+    pending.push_back(std::move(command));
+}
+
+void CoreJournal::Commit()
+{
+    if (pending.empty() == true)
+    {
+        return;
+    }
+    if (saved > static_cast<long long>(current))
+    {
+        saved = -1; // The saved state was in the dropped redo steps.
+    }
+    for (size_t i = current; i < steps.size(); i++)
+    {
+        for (const auto& command : steps[i])
+        {
+            memory -= command->GetMemory();
+        }
+    }
+    steps.resize(current);
+    steps.push_back(std::move(pending));
+    pending.clear();
+    current += 1;
+    if (observer != nullptr)
+    {
+        observer->StepCommitted();
+    }
+}
+
+bool CoreJournal::Undo()
+{
+    Commit();
+    if (CanUndo() == false)
+    {
+        return false;
+    }
+    const Step& step = steps[current - 1];
+    for (size_t i = step.size(); i > 0; i--)
+    {
+        if (step[i - 1]->IsValid(false) == false)
+        {
+            // Only when a replayed journal does not match the document. The commands already
+            // reverted are applied again, the step stays as it was.
+            for (size_t j = i; j < step.size(); j++)
+            {
+                step[j]->Redo();
+            }
+            return false;
+        }
+        step[i - 1]->Undo();
+    }
+    current -= 1;
+    if (observer != nullptr)
+    {
+        observer->StepUndone();
+    }
+    return true;
+}
+
+bool CoreJournal::Redo()
+{
+    if (HasPending() == true || CanRedo() == false)
+    {
+        return false;
+    }
+    const Step& step = steps[current];
+    for (size_t i = 0; i < step.size(); i++)
+    {
+        if (step[i]->IsValid(true) == false)
+        {
+            for (size_t j = i; j > 0; j--)
+            {
+                step[j - 1]->Undo();
+            }
+            return false;
+        }
+        step[i]->Redo();
+    }
+    current += 1;
+    if (observer != nullptr)
+    {
+        observer->StepRedone();
+    }
+    return true;
+}
+
+void CoreJournal::Rewind(size_t step)
+{
+    current = std::min(step, steps.size());
+}
+
+void CoreJournal::Clear()
+{
+    steps.clear();
+    pending.clear();
+    current = 0;
+    saved = 0;
+    memory = 0;
+}
\ No newline at end of file
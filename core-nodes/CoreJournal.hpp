@@ -0,0 +1,85 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Journal                                                                         *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREJOURNAL_HPP
+#define COREJOURNAL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class RecoveryRecord;
+
+// An edit that can be applied again after it has been reverted.
+class CoreCommand
+{
+public:
+    virtual ~CoreCommand() = default;
+    virtual void Undo() = 0;
+    virtual void Redo() = 0;
+    virtual bool IsValid([[maybe_unused]] bool redo) const { return true; } // The nodes and ports the redo, or the undo, refers to exist.
+    virtual size_t GetMemory() const = 0;   // Approximate bytes held by the command.
+    virtual void Write(RecoveryRecord& record) const = 0; // Type of the command, then its fields.
+};
+
+// Follows the history, so the recovery journal can write it to the disk as it changes.
+class JournalObserver
+{
+public:
+    virtual ~JournalObserver() = default;
+    virtual void CommandRecorded(const CoreCommand& command) = 0;
+    virtual void StepCommitted() = 0;
+    virtual void StepUndone() = 0;
+    virtual void StepRedone() = 0;
+};
+
+// Linear undo history. The commands recorded between two commits form one step and are reverted
+// together, in reverse order. The history holds the edits themselves, not copies of the document,
+// so it has no step limit and its size follows the size of the edits.
+class CoreJournal
+{
+public:
+    using Step = std::vector<std::unique_ptr<CoreCommand>>;
+
+private:
+    std::vector<Step> steps;
+    Step pending;
+    size_t current = 0;                     // Steps applied.
+    long long saved = 0;                    // Steps applied at the last save, -1 once that state is dropped.
+    size_t memory = 0;
+    JournalObserver* observer = nullptr;
+
+public:
+    CoreJournal() = default;
+    CoreJournal(const CoreJournal&) = delete;
+    CoreJournal& operator=(const CoreJournal&) = delete;
+    virtual ~CoreJournal() = default;
+    void Record(std::unique_ptr<CoreCommand> command); // The edit is already applied.
+    bool HasPending() const { return pending.empty() == false; }
+    void Commit();                          // Closes the pending commands into a step, drops the redo steps.
+    bool Undo();                            // False if nothing to undo, or at an edit that does not apply.
+    bool Redo();
+    bool CanUndo() const { return current > 0; }
+    bool CanRedo() const { return current < steps.size(); }
+    bool IsSaved() const { return pending.empty() == true && saved == static_cast<long long>(current); }
+    void MarkSaved() { saved = static_cast<long long>(current); }
+    void MarkUnsaved() { saved = -1; }      // The file matches none of the steps.
+    void Clear();
+    size_t GetStepNum() const { return steps.size(); }
+    size_t GetMemory() const { return memory; }
+    void SetObserver(JournalObserver* journalObserver) { observer = journalObserver; }
+
+    // History, for the recovery journal.
+    const std::vector<Step>& GetSteps() const { return steps; }
+    const Step& GetPending() const { return pending; }
+    size_t GetCurrent() const { return current; }
+    void Rewind(size_t step);               // Sets the steps applied without applying them, when a history is restored.
+};
+
+#endif /* COREJOURNAL_HPP */
\ No newline at end of file
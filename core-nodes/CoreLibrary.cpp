@@ -9,17 +9,9 @@
 
 #include "CoreLibrary.hpp"
 
-CoreNode* CoreLibrary::GetNode(std::string_view libName, const std::string& uniqueName)
+CoreNode* CoreLibrary::GetNode(CoreNodePool& pool, std::string_view libName, const std::string& uniqueName)
 {
-    if (libName == "Gain")
-    {
-        return new GainNode(uniqueName);
-    }
-    if (libName == "Test")
-    {
-        return new TestNode(uniqueName);
-    }
-    return nullptr;
+    return CreateNode(pool, libName, uniqueName);
 }
 
 void CoreLibrary::Draw()
@@ -38,6 +30,7 @@ void CoreLibrary::Draw()
     }
 
     DrawBranch("Math", id, libMath);
+    DrawBranch("Continuous", id, libContinuous);
 }
 
 void CoreLibrary::DrawTooltip() const
@@ -10,14 +10,13 @@
 #ifndef CORELIBRARY_HPP
 #define CORELIBRARY_HPP
 
-#include "CoreNode.hpp"
-#include "GainNode.hpp"
-#include "TestNode.hpp"
+#include "CoreFactory.hpp"
 
 class CoreLibrary
 {
 private:
     std::vector<std::string> libMath = { "Gain", "Abs", "Product", "Test"};
+    std::vector<std::string> libContinuous = { "Integrator" };
 
     int iSelectedLeaf = -1;
     int iSelectedBranch = -1;
@@ -29,7 +28,7 @@ private:
 public:
     CoreLibrary() = default;
     virtual ~CoreLibrary() = default;
-    CoreNode* GetNode(std::string_view libName, const std::string & uniqueName);
+    CoreNode* GetNode(CoreNodePool& pool, std::string_view libName, const std::string & uniqueName);
 
     void Draw();
     bool IsLeafClicked() const { return leafClicked; }
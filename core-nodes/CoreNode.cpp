@@ -25,7 +25,7 @@ void CoreNode::AddOutput(CoreNodeOutput output)
     outputVec.push_back(output);
 }
 
-CoreNode::CoreNode(const std::string& name, const std::string& libName, NodeType type, ImColor colorNode) : name(name), libName(libName), type(type), colorNode(colorNode), nameEdited(name)
+CoreNode::CoreNode(const std::string& name, const std::string& libName, NodeType type, ImColor colorNode) : name(name), libName(libName), type(type), colorNode(colorNode)
 {
     flagSet.SetFlag(NodeFlag::Default);
 
@@ -41,41 +41,40 @@ void CoreNode::Save(pugi::xml_node& xmlNode)
 {
     auto node = xmlNode.append_child("node");
     node.append_attribute("name") = name.c_str();
-    SaveString(node, "libName", libName);
-    SaveInt(node, "type", (int)type);
-    SaveImColor(node, "colorNode", colorNode);
-    SaveImColor(node, "colorHead", colorHead);
-    SaveImColor(node, "colorLine", colorLine);
-    SaveImColor(node, "colorBody", colorBody);
-    SaveInt(node, "flagSet", flagSet.GetInt());
-    SaveImRect(node, "rectNode", rectNode);
-    SaveImRect(node, "rectNodeTitle", rectNodeTitle);
-    SaveImRect(node, "rectName", rectName);
-    SaveFloat(node, "titleHeight", titleHeight);
-    SaveFloat(node, "bodyHeight", bodyHeight);
-    auto inputList = node.append_child("inputList");
-    for (const auto& element : inputVec)
+    node.append_attribute("libName") = libName.c_str();
+    node.append_attribute("x") = rectNode.Min.x;
+    node.append_attribute("y") = rectNode.Min.y;
+    node.append_attribute("flags") = flagSet.GetInt() & ~NodeFlag::Hovered;
+    node.append_attribute("inverted") = portInverted;
+    for (const auto* param : GetParams())
     {
-        element.Save(inputList);
+        auto element = node.append_child("param");
+        element.append_attribute("name") = param->GetName().c_str();
+        element.append_attribute("value") = param->Get();
     }
-    auto outputList = node.append_child("outputList");
-    for (const auto& element : outputVec)
+}
+
+void CoreNode::Load(const pugi::xml_node& xmlNode)
+{
+    Build();
+    for (const auto& element : xmlNode.children("param"))
     {
-        element.Save(outputList);
+        SetParam(element.attribute("name").as_string(), element.attribute("value").as_double());
     }
-    SaveImVec2(node, "leftPortPos", leftPortPos);
-    SaveImVec2(node, "rightPortPos", rightPortPos);
-    SaveBool(node, "portInverted", portInverted);
-    SaveFloat(node, "inputsWidth", inputsWidth);
-    SaveFloat(node, "inputsHeight", inputsHeight);
-    SaveFloat(node, "outputsWidth", outputsWidth);
-    SaveFloat(node, "outputsHeight", outputsHeight);
-
-    node.append_child("properties");
-    SaveProperties(node);
+    flagSet.SetInt(xmlNode.attribute("flags").as_int());
+    flagSet.UnsetFlag(NodeFlag::Hovered);
+    if (xmlNode.attribute("inverted").as_bool() == true)
+    {
+        InvertPort();
+    }
+    if (flagSet.HasFlag(NodeFlag::Collapsed) == true)
+    {
+        rectNode.Max.y -= bodyHeight; // Collapsed nodes show the title only.
+    }
+    Translate(ImVec2(xmlNode.attribute("x").as_float(), xmlNode.attribute("y").as_float()));
 }
 
-void CoreNode::Load(const pugi::xml_node& xmlNode)
+void CoreNode::LoadV1(const pugi::xml_node& xmlNode)
 {
     name = xmlNode.attribute("name").as_string();
     libName = LoadString(xmlNode, "libName");
@@ -94,12 +93,12 @@ void CoreNode::Load(const pugi::xml_node& xmlNode)
     for (const auto& element : xmlNode.child("inputList").children("input"))
     {
         inputVec.emplace_back();
-        inputVec.back().Load(element);
+        inputVec.back().LoadV1(element);
     }
     for (const auto& element : xmlNode.child("outputList").children("output"))
     {
         outputVec.emplace_back();
-        outputVec.back().Load(element);
+        outputVec.back().LoadV1(element);
     }
     leftPortPos = LoadImVec2(xmlNode, "leftPortPos");
     rightPortPos = LoadImVec2(xmlNode, "rightPortPos");
@@ -108,61 +107,146 @@ void CoreNode::Load(const pugi::xml_node& xmlNode)
     inputsHeight = LoadFloat(xmlNode, "inputsHeight");
     outputsWidth = LoadFloat(xmlNode, "outputsWidth");
     outputsHeight = LoadFloat(xmlNode, "outputsHeight");
-    nameEdited = name;
 
     xmlNode.child("properties");
     LoadProperties(xmlNode);
 }
 
-bool CoreNode::IsNameUnique(std::string_view str, const std::vector<CoreNode*>& coreNodeVec)
+void CoreNode::Save(CoreBinaryWriter& writer)
+{
+    BinaryNode record;
+    record.name = writer.AddString(name);
+    record.libName = writer.AddString(libName);
+    record.type = (int)type;
+    record.colorNode = ToBinary(colorNode);
+    record.colorHead = ToBinary(colorHead);
+    record.colorLine = ToBinary(colorLine);
+    record.colorBody = ToBinary(colorBody);
+    record.flagSet = flagSet.GetInt();
+    record.rectNode = ToBinary(rectNode);
+    record.rectNodeTitle = ToBinary(rectNodeTitle);
+    record.rectName = ToBinary(rectName);
+    record.titleHeight = titleHeight;
+    record.bodyHeight = bodyHeight;
+    record.firstInput = writer.GetInputNum();
+    record.inputNum = static_cast<uint32_t>(inputVec.size());
+    for (const auto& element : inputVec)
+    {
+        writer.AddInput(element.Save(writer));
+    }
+    record.firstOutput = writer.GetOutputNum();
+    record.outputNum = static_cast<uint32_t>(outputVec.size());
+    for (const auto& element : outputVec)
+    {
+        writer.AddOutput(element.Save(writer));
+    }
+    record.leftPortPos = ToBinary(leftPortPos);
+    record.rightPortPos = ToBinary(rightPortPos);
+    record.portInverted = portInverted;
+    record.inputsWidth = inputsWidth;
+    record.inputsHeight = inputsHeight;
+    record.outputsWidth = outputsWidth;
+    record.outputsHeight = outputsHeight;
+
+    // Properties are the parameters of the node, SaveProperties writes the same values.
+    record.firstParam = writer.GetParamNum();
+    for (const auto* param : GetParams())
+    {
+        writer.AddParam(BinaryParam{ writer.AddString(param->GetName()), param->Get() });
+        record.paramNum++;
+    }
+    writer.AddNode(record);
+}
+
+void CoreNode::Load(const CoreBinaryReader& reader, const BinaryNode& record)
+{
+    name = reader.GetString(record.name);
+    libName = reader.GetString(record.libName);
+    type = (NodeType)record.type;
+    colorNode = FromBinary(record.colorNode);
+    colorHead = FromBinary(record.colorHead);
+    colorLine = FromBinary(record.colorLine);
+    colorBody = FromBinary(record.colorBody);
+    flagSet.SetInt(record.flagSet);
+    flagSet.UnsetFlag(NodeFlag::Hovered);       // Unset hovered flag.
+    rectNode = FromBinary(record.rectNode);
+    rectNodeTitle = FromBinary(record.rectNodeTitle);
+    rectName = FromBinary(record.rectName);
+    titleHeight = record.titleHeight;
+    bodyHeight = record.bodyHeight;
+    inputVec.resize(record.inputNum);
+    for (uint32_t i = 0; i < record.inputNum; i++)
+    {
+        inputVec[i].Load(reader, reader.GetInput(record.firstInput + i));
+    }
+    outputVec.resize(record.outputNum);
+    for (uint32_t i = 0; i < record.outputNum; i++)
+    {
+        outputVec[i].Load(reader, reader.GetOutput(record.firstOutput + i));
+    }
+    leftPortPos = FromBinary(record.leftPortPos);
+    rightPortPos = FromBinary(record.rightPortPos);
+    portInverted = record.portInverted != 0;
+    inputsWidth = record.inputsWidth;
+    inputsHeight = record.inputsHeight;
+    outputsWidth = record.outputsWidth;
+    outputsHeight = record.outputsHeight;
+
+    for (uint32_t i = 0; i < record.paramNum; i++)
+    {
+        const BinaryParam param = reader.GetParam(record.firstParam + i);
+        SetParam(reader.GetString(param.name), param.value);
+    }
+}
+
+void CoreNode::SetParam(const std::string& paramName, double value)
 {
-    for (auto n : coreNodeVec)
+    // Parameters are matched by name, a missing one keeps its default.
+    for (auto* param : GetParams())
     {
-        if (n->GetName() == str)
+        if (param->GetName() == paramName)
         {
-            return false;
+            param->Set(value);
+            return;
         }
     }
-    return true;
 }
 
-void CoreNode::EditName(const std::vector<CoreNode*>& coreNodeVec)
+void CoreNode::SetName(const std::string& newName)
 {
-    ImGui::AlignTextToFramePadding();
-    ImGui::Text("name");
-    ImGui::SameLine(100.0f);
-    ImGui::SetNextItemWidth(140.0f);
-    ImGui::PushStyleColor(ImGuiCol_Text, editingName ? ImVec4(0.992f, 0.914f, 0.169f, 1.0f) : ImGuiStyle().Colors[ImGuiCol_Text]);
-    if (ImGui::InputText(std::string("##" + name).c_str(), &nameEdited, ImGuiInputTextFlags_EnterReturnsTrue)) // ImGuiInputTextFlags_CharsNoBlank
+    // The title width depends on the name. Rebuild the geometry and keep the node in place.
+    name = newName;
+    auto loc = rectNode.Min;
+    BuildGeometry();
+    if (portInverted == true)
     {
-        if (IsNameUnique(nameEdited, coreNodeVec) == true)
+        auto delta = rightPortPos.x - leftPortPos.x;
+        for (auto& input : inputVec)
+        {
+            input.Translate(ImVec2(delta, 0.0f));
+        }
+        for (auto& output : outputVec)
         {
-            name = nameEdited;
-            auto loc = rectNode.Min;
-            BuildGeometry();
-            if (portInverted == true)
-            {
-                auto delta = rightPortPos.x - leftPortPos.x;
-                for (auto& input : inputVec)
-                {
-                    input.Translate(ImVec2(delta, 0.0f));
-                }
-                for (auto& output : outputVec)
-                {
-                    output.Translate(ImVec2(-delta, 0.0f));
-                }
-            }
-            Translate(loc);
-            modifFlag = true;
+            output.Translate(ImVec2(-delta, 0.0f));
         }
-        else if (nameEdited != name)
+    }
+    if (flagSet.HasFlag(NodeFlag::Collapsed) == true)
+    {
+        rectNode.Max.y -= bodyHeight;
+    }
+    Translate(loc);
+}
+
+bool CoreNode::HasIcPort() const
+{
+    for (const auto& input : inputVec)
+    {
+        if (input.GetType() == PortType::Ic)
         {
-            Notifier::Add(Notif(Notif::Type::ERROR, "The name \"" + nameEdited + "\"" + " already exists!", "Enter a unique name.", 5.0f));
-            nameEdited = name;
+            return true;
         }
     }
-    editingName = ImGui::IsItemActive() ? true : false;
-    ImGui::PopStyleColor(1);
+    return false;
 }
 
 void CoreNode::Translate(ImVec2 delta, bool selectedOnly)
@@ -182,6 +266,29 @@ void CoreNode::Translate(ImVec2 delta, bool selectedOnly)
     {
         output.Translate(delta);
     }
+    NotifyMoved();
+}
+
+ImRect CoreNode::GetRectBounds() const
+{
+    ImRect rect = rectNode;
+    for (const auto& input : inputVec)
+    {
+        rect.Add(input.GetRectPin());
+    }
+    for (const auto& output : outputVec)
+    {
+        rect.Add(output.GetRectPin());
+    }
+    return rect;
+}
+
+void CoreNode::NotifyMoved()
+{
+    if (observer != nullptr)
+    {
+        observer->NodeMoved(this);
+    }
 }
 
 void CoreNode::InvertPort()
@@ -208,12 +315,13 @@ void CoreNode::InvertPort()
         output.Invert();
         output.Translate(ImVec2(-delta, 0.0f));
     }
+    NotifyMoved();
 }
 
 void CoreNode::BuildGeometry()
 {
     rectName.Min = ImVec2(0.0f, 0.0f);
-    rectName.Max = ImGui::CalcTextSize(name.c_str());
+    rectName.Max = MeasureText(name);
     titleHeight = kTitleHeight * rectName.GetHeight();
 
     bodyHeight = ImMax(inputsHeight, outputsHeight) + kVerticalTop * rectName.GetHeight() + kVerticalBottom * rectName.GetHeight();
@@ -240,84 +348,4 @@ void CoreNode::BuildGeometry()
     rectNodeTitle.Min = ImVec2(0.0f, 0.0f);
     rectNodeTitle.Max.x = rectNode.Max.x;
     rectNodeTitle.Max.y = titleHeight;
-}
-
-void CoreNode::Draw(ImDrawList* drawList, ImVec2 offset, float scale) const
-{
-    if (flagSet.HasAnyFlag(NodeFlag::Visible) == false)
-    {
-        return;
-    }
-
-    ImRect rect = rectNode;
-    rect.Min *= scale;
-    rect.Max *= scale;
-    rect.Translate(offset);
-    const float rounding = titleHeight * scale * 0.3f;
-    const ImDrawFlags roundCornersFlags = ImDrawFlags_RoundCornersAll;
-
-    if (flagSet.HasAnyFlag(NodeFlag::Hovered)) { /* TODO */ }
-    if (flagSet.HasAnyFlag(NodeFlag::Disabled)) { /* TODO */ }
-
-    // Body
-    drawList->AddRectFilled(rect.Min, rect.Max, colorBody, rounding, roundCornersFlags);
-
-    // Head
-    const ImVec2 headBottomRight = rect.GetTR() + ImVec2(0.0f, titleHeight * scale);
-    const ImDrawFlags headRoundCornersFlags = flagSet.HasAnyFlag(NodeFlag::Collapsed) ? roundCornersFlags : (ImDrawCornerFlags_TopLeft | ImDrawCornerFlags_TopRight);
-    drawList->AddRectFilled(rect.Min, headBottomRight, colorHead, rounding, headRoundCornersFlags);
-
-    // Line
-    if (flagSet.HasAnyFlag(NodeFlag::Collapsed) == false)
-    {
-        drawList->AddLine(ImVec2(rect.Min.x, headBottomRight.y), ImVec2(headBottomRight.x - 1.0f, headBottomRight.y), colorLine, 2.0f);
-    }
-
-    // Name and Shadow
-    ImGui::SetCursorScreenPos(((rectName.Min + ImVec2(2, 2)) * scale) + offset);
-    ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 0, 0, 255));
-    ImGui::Text(name.c_str());
-    ImGui::PopStyleColor();
-    ImGui::SetCursorScreenPos((rectName.Min * scale) + offset);
-    ImGui::Text(name.c_str());
-
-    // Selection
-    if (flagSet.HasAnyFlag(NodeFlag::Selected))
-    {
-        drawList->AddRectFilled(rect.Min, rect.Max, ImColor(1.0f, 1.0f, 1.0f, 0.25f), rounding, roundCornersFlags);
-    }
-
-    // Outline
-    ImColor outlineColor = colorNode;
-    float outlineThickness = 2.0f * scale;
-    if (flagSet.HasAnyFlag(NodeFlag::Highlighted))
-    {
-        outlineColor.Value.x *= 1.5f;
-        outlineColor.Value.y *= 1.5f;
-        outlineColor.Value.z *= 1.5f;
-        outlineColor.Value.w = 1.0f;
-        outlineThickness *= 1.2f;
-    }
-    else
-    {
-        outlineColor.Value.x *= 0.8f;
-        outlineColor.Value.y *= 0.8f;
-        outlineColor.Value.z *= 0.8f;
-        outlineColor.Value.w = 1.0f;
-    }
-    drawList->AddRect(rect.Min, rect.Max, outlineColor, rounding, roundCornersFlags, outlineThickness);
-
-    // Ports
-    if (flagSet.HasAnyFlag(NodeFlag::Collapsed) == false)
-    {
-        for (const auto& input : inputVec)
-            input.Draw(drawList, offset, scale);
-
-        for (const auto& output : outputVec)
-            output.Draw(drawList, offset, scale);
-    }
-    else
-    {
-        // No pin when collapsed.
-    }
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #define CORENODE_HPP
 
 #include "CoreNodePort.hpp"
+#include "CoreProgram.hpp"
 
 struct NodeFlag
 {
@@ -32,6 +33,34 @@ enum class NodeType
     CoreOut // maybe
 };
 
+// Drawing detail, picked by the diagram from the zoom level.
+enum class NodeDetail
+{
+    Full = 0,   // Rounded shapes, names and pins.
+    Simple,     // Shapes and plain pins, no text.
+    Flat        // One quad.
+};
+
+// Slot and generation of a node in its pool, see CoreNodePool.
+struct NodeHandle
+{
+    unsigned int index = 0;
+    unsigned int generation = 0;        // Zero never resolves.
+    bool operator==(const NodeHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const NodeHandle& other) const { return (*this == other) == false; }
+};
+
+class NodeParamDouble;
+class CoreNode;
+
+// Told when the bounds of a node change.
+class NodeObserver
+{
+public:
+    virtual ~NodeObserver() = default;
+    virtual void NodeMoved(CoreNode* node) = 0;
+};
+
 class CoreNode
 {
 private:
@@ -61,49 +90,57 @@ private:
     float inputsHeight = 0.0f;
     float outputsWidth = 0.0f;
     float outputsHeight = 0.0f;
-    std::string nameEdited;
+    NodeObserver* observer = nullptr;
+    void NotifyMoved();
+    NodeHandle handle;
+    void SetParam(const std::string& paramName, double value);
 
 protected:
     void AddInput(CoreNodeInput input);
     void AddOutput(CoreNodeOutput output);
     void BuildGeometry();
-    virtual void SaveProperties(pugi::xml_node& xmlNode) = 0;
-    virtual void LoadProperties(const pugi::xml_node& xmlNode) = 0;
-    bool modifFlag = false;
-
-    static bool IsNameUnique(std::string_view str, const std::vector<CoreNode*>& coreNodeVec);
-    void EditName(const std::vector<CoreNode*>& coreNodeVec);
-    bool editingName = false;
+    virtual void LoadProperties(const pugi::xml_node& xmlNode) = 0; // v0.1.0 files.
 
 public:
     CoreNode() = default;
     CoreNode(const std::string& name, const std::string& libName, NodeType type, ImColor colorNode);
     virtual ~CoreNode() = default;
-    void Save(pugi::xml_node& xmlNode);
-    void Load(const pugi::xml_node& xmlNode);
-    bool GetModifFlag() const { return modifFlag; }
-    void ResetModifFlag() { modifFlag = false; }
+    void Save(pugi::xml_node& xmlNode);     // Authored state only.
+    void Load(const pugi::xml_node& xmlNode); // Builds the node, the name is set by the constructor.
+    void LoadV1(const pugi::xml_node& xmlNode);
+    void Save(CoreBinaryWriter& writer);    // The parameters stand for the properties.
+    void Load(const CoreBinaryReader& reader, const BinaryNode& record);
 
-    std::string GetName() const { return name; }
-    std::string GetLibName() const { return libName; }
+    const std::string& GetName() const { return name; }
+    void SetName(const std::string& newName);
+    const std::string& GetLibName() const { return libName; }
     NodeType GetType() const { return type; };
     FlagSet& GetFlagSet() { return flagSet; }
     const FlagSet& GetFlagSet() const { return flagSet; }
     ImRect GetRectNode() const { return rectNode; }
     ImRect GetRectNodeTitle() const { return rectNodeTitle; }
-    void SetRectNode(const ImRect& rect) { rectNode = rect; }
+    void SetRectNode(const ImRect& rect) { rectNode = rect; NotifyMoved(); }
+    ImRect GetRectBounds() const; // Node and pins.
+    void SetObserver(NodeObserver* nodeObserver) { observer = nodeObserver; }
+    NodeHandle GetHandle() const { return handle; }
+    void SetHandle(NodeHandle nodeHandle) { handle = nodeHandle; }
     float GetBodyHeight() const { return bodyHeight; }
     std::vector<CoreNodeInput>& GetInputVec() { return inputVec; }
     const std::vector<CoreNodeInput>& GetInputVec() const { return inputVec; }
     std::vector<CoreNodeOutput>& GetOutputVec() { return outputVec; }
+    const std::vector<CoreNodeOutput>& GetOutputVec() const { return outputVec; }
+    bool HasIcPort() const;
 
     void Translate(ImVec2 delta, bool selectedOnly = false);
-    void Draw(ImDrawList* drawList, ImVec2 offset, float scale) const;
+    void Draw(ImDrawList* drawList, ImVec2 offset, float scale, NodeDetail detail = NodeDetail::Full) const;
+    unsigned long long GetDrawSignature(NodeDetail detail) const; // Changes with anything Draw depends on.
     void InvertPort();
     bool IsPortInverted() const { return portInverted; }
 
     virtual void Build() = 0;
-    virtual void DrawProperties(const std::vector<CoreNode*>& coreNodeVec) = 0;
+    virtual void Compile(NodeKernel& kernel) const = 0;
+    virtual std::string GetDescription() const = 0;
+    virtual std::vector<NodeParamDouble*> GetParams() = 0;
 };
 
 class NodeParamDouble
@@ -116,23 +153,10 @@ private:
 public:
     explicit NodeParamDouble(const std::string& name, double v) : name(name), data(v) {}
     virtual ~NodeParamDouble() = default;
+    const std::string& GetName() const { return name; }
     double Get() const { return data; }
     void Set(double v) { data = v; }
-    void Draw(bool& modifFlag, double step = 0.0, double stepFast = 0.0)
-    {
-        ImGui::AlignTextToFramePadding();
-        ImGui::Text(name.c_str());
-        ImGui::SameLine(100.0f);
-        ImGui::SetNextItemWidth(140.0f);
-        ImGui::PushStyleColor(ImGuiCol_Text, edit ? ImVec4(0.992f, 0.914f, 0.169f, 1.0f) : ImGuiStyle().Colors[ImGuiCol_Text]);
-        if (ImGui::InputDouble(std::string("##" + name).c_str(), &data, step, stepFast, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
-        {
-            edit = false;
-            modifFlag = true;
-        }
-        edit = ImGui::IsItemActive() ? true : false;
-        ImGui::PopStyleColor(1);
-    }
+    void Draw(bool& entered, double step = 0.0, double stepFast = 0.0);
 };
 
 #endif /* CORENODE_HPP */
\ No newline at end of file
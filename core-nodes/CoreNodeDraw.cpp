@@ -0,0 +1,422 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Node Draw                                                                       *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+// Drawing of nodes, ports and parameters. Part of the application, not of the model library.
+
+#include "CoreNode.hpp"
+#include "CoreDrawCache.hpp"
+
+void CoreNode::Draw(ImDrawList* drawList, ImVec2 offset, float scale, NodeDetail detail) const
+{
+    if (flagSet.HasAnyFlag(NodeFlag::Visible) == false)
+    {
+        return;
+    }
+
+    ImRect rect = rectNode;
+    rect.Min *= scale;
+    rect.Max *= scale;
+    rect.Translate(offset);
+
+    if (detail == NodeDetail::Flat)
+    {
+        ImColor color = colorHead;
+        if (flagSet.HasAnyFlag(NodeFlag::Selected | NodeFlag::Highlighted))
+        {
+            color.Value.x = ImMin(color.Value.x * 1.5f + 0.25f, 1.0f);
+            color.Value.y = ImMin(color.Value.y * 1.5f + 0.25f, 1.0f);
+            color.Value.z = ImMin(color.Value.z * 1.5f + 0.25f, 1.0f);
+        }
+        drawList->AddRectFilled(rect.Min, rect.Max, color);
+        return;
+    }
+    if (detail == NodeDetail::Simple)
+    {
+        const ImVec2 headBottomRight = rect.GetTR() + ImVec2(0.0f, titleHeight * scale);
+        drawList->AddRectFilled(rect.Min, rect.Max, colorBody);
+        drawList->AddRectFilled(rect.Min, headBottomRight, colorHead);
+        if (flagSet.HasAnyFlag(NodeFlag::Selected))
+        {
+            drawList->AddRectFilled(rect.Min, rect.Max, ImColor(1.0f, 1.0f, 1.0f, 0.25f));
+        }
+        if (flagSet.HasAnyFlag(NodeFlag::Highlighted))
+        {
+            drawList->AddRect(rect.Min, rect.Max, ImColor(1.0f, 1.0f, 1.0f, 1.0f));
+        }
+        if (flagSet.HasAnyFlag(NodeFlag::Collapsed) == false)
+        {
+            for (const auto& input : inputVec)
+                input.DrawPin(drawList, offset, scale);
+
+            for (const auto& output : outputVec)
+                output.DrawPin(drawList, offset, scale);
+        }
+        return;
+    }
+    const float rounding = titleHeight * scale * 0.3f;
+    const ImDrawFlags roundCornersFlags = ImDrawFlags_RoundCornersAll;
+
+    if (flagSet.HasAnyFlag(NodeFlag::Hovered)) { /* TODO */ }
+    if (flagSet.HasAnyFlag(NodeFlag::Disabled)) { /* TODO */ }
+
+    // Body
+    drawList->AddRectFilled(rect.Min, rect.Max, colorBody, rounding, roundCornersFlags);
+
+    // Head
+    const ImVec2 headBottomRight = rect.GetTR() + ImVec2(0.0f, titleHeight * scale);
+    const ImDrawFlags headRoundCornersFlags = flagSet.HasAnyFlag(NodeFlag::Collapsed) ? roundCornersFlags : (ImDrawCornerFlags_TopLeft | ImDrawCornerFlags_TopRight);
+    drawList->AddRectFilled(rect.Min, headBottomRight, colorHead, rounding, headRoundCornersFlags);
+
+    // Line
+    if (flagSet.HasAnyFlag(NodeFlag::Collapsed) == false)
+    {
+        drawList->AddLine(ImVec2(rect.Min.x, headBottomRight.y), ImVec2(headBottomRight.x - 1.0f, headBottomRight.y), colorLine, 2.0f);
+    }
+
+    // Name and Shadow
+    ImGui::SetCursorScreenPos(((rectName.Min + ImVec2(2, 2)) * scale) + offset);
+    ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 0, 0, 255));
+    ImGui::Text(name.c_str());
+    ImGui::PopStyleColor();
+    ImGui::SetCursorScreenPos((rectName.Min * scale) + offset);
+    ImGui::Text(name.c_str());
+
+    // Selection
+    if (flagSet.HasAnyFlag(NodeFlag::Selected))
+    {
+        drawList->AddRectFilled(rect.Min, rect.Max, ImColor(1.0f, 1.0f, 1.0f, 0.25f), rounding, roundCornersFlags);
+    }
+
+    // Outline
+    ImColor outlineColor = colorNode;
+    float outlineThickness = 2.0f * scale;
+    if (flagSet.HasAnyFlag(NodeFlag::Highlighted))
+    {
+        outlineColor.Value.x *= 1.5f;
+        outlineColor.Value.y *= 1.5f;
+        outlineColor.Value.z *= 1.5f;
+        outlineColor.Value.w = 1.0f;
+        outlineThickness *= 1.2f;
+    }
+    else
+    {
+        outlineColor.Value.x *= 0.8f;
+        outlineColor.Value.y *= 0.8f;
+        outlineColor.Value.z *= 0.8f;
+        outlineColor.Value.w = 1.0f;
+    }
+    drawList->AddRect(rect.Min, rect.Max, outlineColor, rounding, roundCornersFlags, outlineThickness);
+
+    // Ports
+    if (flagSet.HasAnyFlag(NodeFlag::Collapsed) == false)
+    {
+        for (const auto& input : inputVec)
+            input.Draw(drawList, offset, scale);
+
+        for (const auto& output : outputVec)
+            output.Draw(drawList, offset, scale);
+    }
+    else
+    {
+        // No pin when collapsed.
+    }
+}
+
+unsigned long long CoreNode::GetDrawSignature(NodeDetail detail) const
+{
+    unsigned long long hash = HashDraw(hashDrawSeed, detail);
+    hash = HashDraw(hash, rectNode);
+    hash = HashDraw(hash, rectName);
+    hash = HashDraw(hash, titleHeight);
+    hash = HashDraw(hash, flagSet.GetInt());
+    hash = HashDraw(hash, colorNode.Value);
+    hash = HashDraw(hash, colorHead.Value);
+    hash = HashDraw(hash, colorLine.Value);
+    hash = HashDraw(hash, colorBody.Value);
+    hash = HashDraw(hash, name.data(), name.size());
+    for (const auto& input : inputVec)
+    {
+        hash = input.GetDrawSignature(hash);
+    }
+    for (const auto& output : outputVec)
+    {
+        hash = output.GetDrawSignature(hash);
+    }
+    return hash;
+}
+
+void CoreNodeInput::Draw(ImDrawList* drawList, ImVec2 offset, float scale) const
+{
+    if (type == PortType::None)
+    {
+        return;
+    }
+
+    ImGui::SetCursorScreenPos((rectName.Min * scale) + offset);
+    ImGui::Text(name.c_str());
+
+    // Show type.
+    if (flagSet.Equal(PortFlag::Draging) && targetNode == nullptr)
+    {
+        std::string typeName = portTypeNames.at(static_cast<int>(dataType));
+        ImVec2 typeNameSize = ImGui::CalcTextSize(typeName.c_str());
+        auto distText = ImVec2(10.0f, 0.0f);
+        if (inverted == true)
+        {
+            auto point = ImVec2(rectName.Min.x + rectName.GetWidth() + rectPin.GetWidth(), rectName.Min.y) + distText;
+            ImGui::SetCursorScreenPos((point * scale) + offset);
+        }
+        else
+        {
+            auto point = ImVec2(rectName.Min.x - rectPin.GetWidth(), rectName.Min.y) - distText;
+            ImGui::SetCursorScreenPos((point * scale - ImVec2(typeNameSize.x, 0.0f)) + offset);
+        }
+        auto typeColor = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // data type text color
+        ImGui::TextColored(typeColor, typeName.c_str());
+    }
+
+    auto center = ImVec2((position * scale) + offset);
+    auto radius1 = kPin * rectName.GetHeight() * 0.5f * scale;
+    auto radius2 = kPin * rectName.GetHeight() * 0.5f * scale * 0.5f;
+    auto radius3 = kPin * rectName.GetHeight() * 0.5f * scale * 0.8f;
+    auto thickness1 = 0.1f * rectName.GetHeight() * scale;
+
+    auto color1 = ImColor(0.000f, 0.459f, 0.388f, 1.0f); // background
+    auto color2 = ImColor(0.341f, 0.659f, 0.769f, 1.0f); // teal ring
+    auto color3 = ImColor(1.000f, 1.000f, 1.000f, 1.0f); // white
+    auto color4 = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // orange
+    auto color5 = ImColor(1.000f, 0.824f, 0.000f, 1.0f); // orange for ic
+
+    drawList->AddCircleFilled(center, radius1, color1, 0); // Background
+    drawList->AddCircle(center, radius1, color2, 0, thickness1); // Outer ring
+
+    float distTri = radius1 * 1.6f;
+    float triLength = radius1;
+    if (flagSet.Equal(PortFlag::Draging) && type == PortType::In && targetNode == nullptr)
+    {
+        if (inverted == false)
+        {
+            auto loc = ImVec2(center.x - distTri, center.y);
+            drawList->AddTriangleFilled(loc + ImVec2(-triLength, triLength), loc + ImVec2(-triLength, -triLength), loc, color4);
+        }
+        else
+        {
+            auto loc = ImVec2(center.x + distTri, center.y);
+            drawList->AddTriangleFilled(loc + ImVec2(triLength, triLength), loc + ImVec2(triLength, -triLength), loc, color4);
+        }
+    }
+    else if (flagSet.Equal(PortFlag::Draging) && type == PortType::Ic && targetNode == nullptr)
+    {
+        if (inverted == false)
+        {
+            auto loc = ImVec2(center.x - distTri, center.y);
+            drawList->AddTriangleFilled(loc + ImVec2(-triLength, triLength), loc + ImVec2(-triLength, -triLength), loc, color5);
+        }
+        else
+        {
+            auto loc = ImVec2(center.x + distTri, center.y);
+            drawList->AddTriangleFilled(loc + ImVec2(triLength, triLength), loc + ImVec2(triLength, -triLength), loc, color5);
+        }
+    }
+
+    if (targetNode == nullptr)
+    {
+        if (flagSet.Equal(PortFlag::Hovered))
+        {
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+        if (flagSet.Equal(PortFlag::Connectible))
+        {
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+        if (flagSet.Equal(PortFlag::Draging))
+        {
+            drawList->AddCircleFilled(center, radius3, color4);
+        }
+        if (flagSet.Equal(PortFlag::Hovered | PortFlag::Connectible))
+        {
+            drawList->AddCircleFilled(center, radius3, color4);
+        }
+    }
+    else
+    {
+        drawList->AddCircleFilled(center, radius2, color3); // Inner circle
+        if (flagSet.Equal(PortFlag::Hovered))
+        {
+            // drawList->AddRect(rectPort.Min * scale + offset, rectPort.Max * scale + offset, ImColor(1.0f, 0.0f, 0.0f, 0.5f));
+        }
+        if (flagSet.Equal(PortFlag::Connectible))
+        {
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+    }
+}
+
+void CoreNodeInput::DrawPin(ImDrawList* drawList, ImVec2 offset, float scale) const
+{
+    if (type == PortType::None)
+    {
+        return;
+    }
+    auto center = ImVec2((position * scale) + offset);
+    auto radius = kPin * rectName.GetHeight() * 0.5f * scale;
+    auto color = targetNode == nullptr ? ImColor(0.341f, 0.659f, 0.769f, 1.0f) : ImColor(1.000f, 1.000f, 1.000f, 1.0f);
+    drawList->AddCircleFilled(center, radius, color, 6);
+}
+
+unsigned long long CoreNodeInput::GetDrawSignature(unsigned long long hash) const
+{
+    hash = HashDraw(hash, position);
+    hash = HashDraw(hash, rectName);
+    hash = HashDraw(hash, flagSet.GetInt());
+    hash = HashDraw(hash, type);
+    hash = HashDraw(hash, dataType);
+    hash = HashDraw(hash, inverted);
+    hash = HashDraw(hash, targetNode != nullptr);
+    return HashDraw(hash, name.data(), name.size());
+}
+
+void CoreNodeOutput::Draw(ImDrawList* drawList, ImVec2 offset, float scale) const
+{
+    if (type == PortType::None)
+    {
+        return;
+    }
+
+    ImGui::SetCursorScreenPos((rectName.Min * scale) + offset);
+    ImGui::Text(name.c_str());
+
+    // Show type.
+    if (flagSet.Equal(PortFlag::Draging))
+    {
+        std::string typeName = portTypeNames.at(static_cast<int>(dataType));
+        ImVec2 typeNameSize = ImGui::CalcTextSize(typeName.c_str());
+        auto distText = ImVec2(10.0f, 0.0f);
+        if (inverted == false)
+        {
+            auto point = ImVec2(rectName.Min.x + rectName.GetWidth() + rectPin.GetWidth(), rectName.Min.y) + distText;
+            ImGui::SetCursorScreenPos((point * scale) + offset);
+        }
+        else
+        {
+            auto point = ImVec2(rectName.Min.x - rectPin.GetWidth(), rectName.Min.y) - distText;
+            ImGui::SetCursorScreenPos((point * scale - ImVec2(typeNameSize.x, 0.0f)) + offset);
+        }
+        auto typeColor = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // data type text color
+        ImGui::TextColored(typeColor, typeName.c_str());
+    }
+
+    auto center = ImVec2((position * scale) + offset);
+    auto radius1 = kPin * rectName.GetHeight() * 0.5f * scale;
+    auto radius2 = kPin * rectName.GetHeight() * 0.5f * scale * 0.5f;
+    auto radius3 = kPin * rectName.GetHeight() * 0.5f * scale * 0.8f;
+
+    auto thickness1 = 0.1f * rectName.GetHeight() * scale;
+
+    auto color1 = ImColor(0.000f, 0.459f, 0.388f, 1.0f); // background
+    auto color2 = ImColor(0.341f, 0.659f, 0.769f, 1.0f); // teal ring
+    auto color3 = ImColor(1.000f, 1.000f, 1.000f, 1.0f); // white
+    auto color4 = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // orange
+
+    drawList->AddCircleFilled(center, radius1, color1, 0); // Background
+    drawList->AddCircle(center, radius1, color2, 0, thickness1); // Outer ring
+
+    float distTri = radius1 * 1.6f;
+    float triLength = radius1;
+    if (flagSet.Equal(PortFlag::Draging) && type == PortType::Out)
+    {
+        if (inverted == false)
+        {
+            auto loc = ImVec2(center.x + distTri + radius1, center.y);
+            drawList->AddTriangleFilled(loc + ImVec2(-triLength, triLength), loc + ImVec2(-triLength, -triLength), loc, color4);
+        }
+        else
+        {
+            auto loc = ImVec2(center.x - distTri - radius1, center.y);
+            drawList->AddTriangleFilled(loc + ImVec2(triLength, triLength), loc + ImVec2(triLength, -triLength), loc, color4);
+        }
+    }
+
+    if (linkNum == 0)
+    {
+        if (flagSet.Equal(PortFlag::Hovered))
+        {
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+        if (flagSet.Equal(PortFlag::Connectible))
+        {
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+        if (flagSet.Equal(PortFlag::Draging))
+        {
+            drawList->AddCircleFilled(center, radius3, color4);
+        }
+        if (flagSet.Equal(PortFlag::Hovered | PortFlag::Connectible))
+        {
+            drawList->AddCircleFilled(center, radius3, color4);
+        }
+    }
+    else
+    {
+        drawList->AddCircleFilled(center, radius2, color3); // Inner circle
+        if (flagSet.Equal(PortFlag::Hovered))
+        {
+            // drawList->AddRect(rectPort.Min * scale + offset, rectPort.Max * scale + offset, ImColor(1.0f, 0.0f, 0.0f, 0.5f));
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+        if (flagSet.Equal(PortFlag::Draging))
+        {
+            drawList->AddCircleFilled(center, radius3, color4);
+        }
+        if (flagSet.Equal(PortFlag::Connectible))
+        {
+            drawList->AddCircleFilled(center, radius2, color4);
+        }
+    }
+}
+
+void CoreNodeOutput::DrawPin(ImDrawList* drawList, ImVec2 offset, float scale) const
+{
+    if (type == PortType::None)
+    {
+        return;
+    }
+    auto center = ImVec2((position * scale) + offset);
+    auto radius = kPin * rectName.GetHeight() * 0.5f * scale;
+    auto color = linkNum == 0 ? ImColor(0.341f, 0.659f, 0.769f, 1.0f) : ImColor(1.000f, 1.000f, 1.000f, 1.0f);
+    drawList->AddCircleFilled(center, radius, color, 6);
+}
+
+unsigned long long CoreNodeOutput::GetDrawSignature(unsigned long long hash) const
+{
+    hash = HashDraw(hash, position);
+    hash = HashDraw(hash, rectName);
+    hash = HashDraw(hash, flagSet.GetInt());
+    hash = HashDraw(hash, type);
+    hash = HashDraw(hash, dataType);
+    hash = HashDraw(hash, inverted);
+    hash = HashDraw(hash, linkNum);
+    return HashDraw(hash, name.data(), name.size());
+}
+
+void NodeParamDouble::Draw(bool& entered, double step, double stepFast)
+{
+    ImGui::AlignTextToFramePadding();
+    ImGui::Text(name.c_str());
+    ImGui::SameLine(100.0f);
+    ImGui::SetNextItemWidth(140.0f);
+    ImGui::PushStyleColor(ImGuiCol_Text, edit ? ImVec4(0.992f, 0.914f, 0.169f, 1.0f) : ImGuiStyle().Colors[ImGuiCol_Text]);
+    if (ImGui::InputDouble(std::string("##" + name).c_str(), &data, step, stepFast, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
+    {
+        edit = false;
+        entered = true;
+    }
+    edit = ImGui::IsItemActive() ? true : false;
+    ImGui::PopStyleColor(1);
+}
\ No newline at end of file
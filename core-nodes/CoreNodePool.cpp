@@ -0,0 +1,129 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Node Pool                                                                       *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreNodePool.hpp"
+#include <new>
+
+CoreNodePool::Slab::Slab(size_t size, size_t align) : slotSize((size + align - 1) / align * align), slotAlign(align)
+{
+}
+
+CoreNodePool::Slab::~Slab()
+{
+    for (const auto& chunk : chunks)
+    {
+        ::operator delete(chunk, std::align_val_t(slotAlign));
+    }
+}
+
+void* CoreNodePool::Slab::Allocate()
+{
+    if (freeSlots.empty() == true)
+    {
+        auto* chunk = static_cast<unsigned char*>(::operator new(slotSize * chunkSlots, std::align_val_t(slotAlign)));
+        chunks.push_back(chunk);
+        for (size_t i = chunkSlots; i > 0; i--)
+        {
+            freeSlots.push_back(chunk + (i - 1) * slotSize); // Lowest address is handed out first.
+        }
+    }
+    void* memory = freeSlots.back();
+    freeSlots.pop_back();
+    return memory;
+}
+
+CoreNodePool::~CoreNodePool()
+{
+    Clear();
+}
+
+CoreNodePool::Slab& CoreNodePool::GetSlab(std::type_index type, size_t size, size_t align)
+{
+    auto& slab = slabs[type];
+    if (slab == nullptr)
+    {
+        slab = std::make_unique<Slab>(size, align);
+    }
+    return *slab;
+}
+
+CoreNode* CoreNodePool::Register(CoreNode* node, void* memory, Slab& slab)
+{
+    unsigned int index;
+    if (freeIndices.empty() == false)
+    {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else
+    {
+        index = static_cast<unsigned int>(slots.size());
+        slots.emplace_back();
+    }
+    Slot& slot = slots[index];
+    slot.node = node;
+    slot.memory = memory;
+    slot.slab = &slab;
+    node->SetHandle(NodeHandle{ index, slot.generation });
+    liveNum += 1;
+    return node;
+}
+
+void CoreNodePool::Destroy(CoreNode* node)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+    const NodeHandle handle = node->GetHandle();
+    if (Get(handle) != node)
+    {
+        return; // Destroyed already or not from this pool.
+    }
+    Slot& slot = slots[handle.index];
+    node->~CoreNode();
+    slot.slab->Free(slot.memory);
+    slot.node = nullptr;
+    slot.memory = nullptr;
+    slot.slab = nullptr;
+    slot.generation += 1; // Handles to the old node no longer resolve.
+    freeIndices.push_back(handle.index);
+    liveNum -= 1;
+}
+
+void CoreNodePool::Clear()
+{
+    for (auto& slot : slots)
+    {
+        if (slot.node != nullptr)
+        {
+            slot.node->~CoreNode();
+            slot.slab->Free(slot.memory);
+            slot.node = nullptr;
+            slot.memory = nullptr;
+            slot.slab = nullptr;
+            slot.generation += 1;
+        }
+    }
+    freeIndices.clear();
+    for (unsigned int i = static_cast<unsigned int>(slots.size()); i > 0; i--)
+    {
+        freeIndices.push_back(i - 1);
+    }
+    liveNum = 0;
+}
+
+CoreNode* CoreNodePool::Get(NodeHandle handle) const
+{
+    if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation)
+    {
+        return nullptr;
+    }
+    return slots[handle.index].node;
+}
\ No newline at end of file
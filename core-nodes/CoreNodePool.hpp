@@ -0,0 +1,86 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Node Pool                                                                       *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORENODEPOOL_HPP
+#define CORENODEPOOL_HPP
+
+#include "CoreNode.hpp"
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+
+// Storage of the nodes of a graph. Each node type has its own slab of fixed-size slots allocated
+// in chunks, so nodes of a type sit next to each other and freed slots are reused without the heap.
+// A node never moves, the pointers to it and to its ports stay valid until it is destroyed.
+// Handles carry the generation of their slot and stop resolving once the node is destroyed.
+class CoreNodePool
+{
+private:
+    class Slab
+    {
+    private:
+        size_t slotSize;
+        size_t slotAlign;
+        const size_t chunkSlots = 64;
+        std::vector<void*> chunks;
+        std::vector<void*> freeSlots;
+    public:
+        Slab(size_t size, size_t align);
+        Slab(const Slab&) = delete;
+        Slab& operator=(const Slab&) = delete;
+        virtual ~Slab();
+        void* Allocate();
+        void Free(void* memory) { freeSlots.push_back(memory); }
+        size_t GetChunkNum() const { return chunks.size(); }
+    };
+    struct Slot
+    {
+        CoreNode* node = nullptr;
+        void* memory = nullptr;             // Start of the derived object.
+        Slab* slab = nullptr;
+        unsigned int generation = 1;
+    };
+    std::unordered_map<std::type_index, std::unique_ptr<Slab>> slabs;
+    std::vector<Slot> slots;
+    std::vector<unsigned int> freeIndices;
+    int liveNum = 0;
+    Slab& GetSlab(std::type_index type, size_t size, size_t align);
+    CoreNode* Register(CoreNode* node, void* memory, Slab& slab);
+
+public:
+    CoreNodePool() = default;
+    CoreNodePool(const CoreNodePool&) = delete;
+    CoreNodePool& operator=(const CoreNodePool&) = delete;
+    virtual ~CoreNodePool();
+
+    template<typename T>
+    T* Create(const std::string& uniqueName)
+    {
+        Slab& slab = GetSlab(typeid(T), sizeof(T), alignof(T));
+        void* memory = slab.Allocate();
+        T* node = nullptr;
+        try
+        {
+            node = new (memory) T(uniqueName);
+        }
+        catch (...)
+        {
+            slab.Free(memory);
+            throw;
+        }
+        Register(node, memory, slab);
+        return node;
+    }
+    void Destroy(CoreNode* node);
+    void Clear();                           // Destroys every node, the slabs are kept for the next ones.
+    CoreNode* Get(NodeHandle handle) const; // nullptr once the node is destroyed.
+    int GetLiveNum() const { return liveNum; }
+};
+
+#endif /* CORENODEPOOL_HPP */
\ No newline at end of file
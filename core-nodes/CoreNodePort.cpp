@@ -9,13 +9,31 @@
 
 #include "CoreNodePort.hpp"
 
+static ImVec2 DefaultTextSize(const std::string& text)
+{
+    // Fixed width estimate of the default font, for use without the application.
+    return ImVec2(7.0f * static_cast<float>(text.size()), 13.0f);
+}
+
+static TextSizeFunc textSizeFunc = &DefaultTextSize;
+
+void SetTextSizeFunc(TextSizeFunc func)
+{
+    textSizeFunc = func != nullptr ? func : &DefaultTextSize;
+}
+
+ImVec2 MeasureText(const std::string& text)
+{
+    return textSizeFunc(text);
+}
+
 CoreNodeInput::CoreNodeInput(const std::string& name, PortType type, PortDataType dataType) :
     name(name), type(type), dataType(dataType)
 {
     flagSet.SetFlag(PortFlag::Default);
 
     rectName.Min = ImVec2(0.0f, 0.0f);
-    rectName.Max = ImGui::CalcTextSize(name.c_str());
+    rectName.Max = MeasureText(name);
     ref = rectName.GetHeight();
     rectPin = ImRect(ImVec2(0.0f, 0.0f), ImVec2((kPadding + kPin + kPadding) * ref, kHeight * ref));
     rectName.Translate(ImVec2(rectPin.GetWidth(), (rectPin.GetHeight() - rectName.GetHeight()) * 0.5f));
@@ -27,28 +45,7 @@ CoreNodeInput::CoreNodeInput(const std::string& name, PortType type, PortDataTyp
     rectPort.Translate(offset);
 }
 
-void CoreNodeInput::Save(pugi::xml_node& xmlNode) const
-{
-    auto node = xmlNode.append_child("input");
-    node.append_attribute("name").set_value(name.c_str());
-    SaveImVec2(node, "position", position);
-    SaveFloat(node, "ref", ref);
-    SaveImRect(node, "rectName", rectName);
-    SaveImRect(node, "rectPin", rectPin);
-    SaveImRect(node, "rectPort", rectPort);
-    SaveInt(node, "type", (int)type);
-    SaveInt(node, "dataType", (int)dataType);
-    SaveInt(node, "order", order);
-    SaveInt(node, "flagSet", flagSet.GetInt());
-    SaveBool(node, "inverted", inverted);
-    SaveInt(node, "linkDir", linkDir);
-    SaveInt(node, "linkSepX", linkSepX);
-    SaveInt(node, "linkSepY", linkSepY);
-    SaveInt(node, "targetLinkDir", targetLinkDir);
-    SaveInt(node, "targetLinkSep", targetLinkSep);
-}
-
-void CoreNodeInput::Load(const pugi::xml_node & xmlNode)
+void CoreNodeInput::LoadV1(const pugi::xml_node & xmlNode)
 {
     name = xmlNode.attribute("name").as_string();
     position = LoadImVec2(xmlNode, "position");
@@ -68,6 +65,48 @@ void CoreNodeInput::Load(const pugi::xml_node & xmlNode)
     targetLinkSep = LoadInt(xmlNode, "targetLinkSep");
 }
 
+BinaryPort CoreNodeInput::Save(CoreBinaryWriter& writer) const
+{
+    BinaryPort record;
+    record.name = writer.AddString(name);
+    record.position = ToBinary(position);
+    record.ref = ref;
+    record.rectName = ToBinary(rectName);
+    record.rectPin = ToBinary(rectPin);
+    record.rectPort = ToBinary(rectPort);
+    record.type = (int)type;
+    record.dataType = (int)dataType;
+    record.order = order;
+    record.flagSet = flagSet.GetInt();
+    record.inverted = inverted;
+    record.linkDir = linkDir;
+    record.linkSepX = linkSepX;
+    record.linkSepY = linkSepY;
+    record.targetLinkDir = targetLinkDir;
+    record.targetLinkSep = targetLinkSep;
+    return record;
+}
+
+void CoreNodeInput::Load(const CoreBinaryReader& reader, const BinaryPort& record)
+{
+    name = reader.GetString(record.name);
+    position = FromBinary(record.position);
+    ref = record.ref;
+    rectName = FromBinary(record.rectName);
+    rectPin = FromBinary(record.rectPin);
+    rectPort = FromBinary(record.rectPort);
+    type = (PortType)record.type;
+    dataType = (PortDataType)record.dataType;
+    order = record.order;
+    flagSet.SetInt(record.flagSet);
+    inverted = record.inverted != 0;
+    linkDir = record.linkDir;
+    linkSepX = record.linkSepX;
+    linkSepY = record.linkSepY;
+    targetLinkDir = record.targetLinkDir;
+    targetLinkSep = record.targetLinkSep;
+}
+
 void CoreNodeInput::BreakLink()
 {
     if (targetNodeOutput != nullptr)
@@ -109,119 +148,12 @@ void CoreNodeInput::Invert()
     }
 }
 
-void CoreNodeInput::Draw(ImDrawList* drawList, ImVec2 offset, float scale) const
-{
-    if (type == PortType::None)
-    {
-        return;
-    }
-
-    ImGui::SetCursorScreenPos((rectName.Min * scale) + offset);
-    ImGui::Text(name.c_str());
-
-    // Show type.
-    if (flagSet.Equal(PortFlag::Draging) && targetNode == nullptr)
-    {
-        std::string typeName = portTypeNames.at(static_cast<int>(dataType));
-        ImVec2 typeNameSize = ImGui::CalcTextSize(typeName.c_str());
-        auto distText = ImVec2(10.0f, 0.0f);
-        if (inverted == true)
-        {
-            auto point = ImVec2(rectName.Min.x + rectName.GetWidth() + rectPin.GetWidth(), rectName.Min.y) + distText;
-            ImGui::SetCursorScreenPos((point * scale) + offset);
-        }
-        else
-        {
-            auto point = ImVec2(rectName.Min.x - rectPin.GetWidth(), rectName.Min.y) - distText;
-            ImGui::SetCursorScreenPos((point * scale - ImVec2(typeNameSize.x, 0.0f)) + offset);
-        }
-        auto typeColor = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // data type text color
-        ImGui::TextColored(typeColor, typeName.c_str());
-    }
-
-    auto center = ImVec2((position * scale) + offset);
-    auto radius1 = kPin * rectName.GetHeight() * 0.5f * scale;
-    auto radius2 = kPin * rectName.GetHeight() * 0.5f * scale * 0.5f;
-    auto radius3 = kPin * rectName.GetHeight() * 0.5f * scale * 0.8f;
-    auto thickness1 = 0.1f * rectName.GetHeight() * scale;
-
-    auto color1 = ImColor(0.000f, 0.459f, 0.388f, 1.0f); // background
-    auto color2 = ImColor(0.341f, 0.659f, 0.769f, 1.0f); // teal ring
-    auto color3 = ImColor(1.000f, 1.000f, 1.000f, 1.0f); // white
-    auto color4 = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // orange
-    auto color5 = ImColor(1.000f, 0.824f, 0.000f, 1.0f); // orange for ic
-
-    drawList->AddCircleFilled(center, radius1, color1, 0); // Background
-    drawList->AddCircle(center, radius1, color2, 0, thickness1); // Outer ring
-
-    float distTri = radius1 * 1.6f;
-    float triLength = radius1;
-    if (flagSet.Equal(PortFlag::Draging) && type == PortType::In && targetNode == nullptr)
-    {
-        if (inverted == false)
-        {
-            auto loc = ImVec2(center.x - distTri, center.y);
-            drawList->AddTriangleFilled(loc + ImVec2(-triLength, triLength), loc + ImVec2(-triLength, -triLength), loc, color4);
-        }
-        else
-        {
-            auto loc = ImVec2(center.x + distTri, center.y);
-            drawList->AddTriangleFilled(loc + ImVec2(triLength, triLength), loc + ImVec2(triLength, -triLength), loc, color4);
-        }
-    }
-    else if (flagSet.Equal(PortFlag::Draging) && type == PortType::Ic && targetNode == nullptr)
-    {
-        if (inverted == false)
-        {
-            auto loc = ImVec2(center.x - distTri, center.y);
-            drawList->AddTriangleFilled(loc + ImVec2(-triLength, triLength), loc + ImVec2(-triLength, -triLength), loc, color5);
-        }
-        else
-        {
-            auto loc = ImVec2(center.x + distTri, center.y);
-            drawList->AddTriangleFilled(loc + ImVec2(triLength, triLength), loc + ImVec2(triLength, -triLength), loc, color5);
-        }
-    }
-
-    if (targetNode == nullptr)
-    {
-        if (flagSet.Equal(PortFlag::Hovered))
-        {
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-        if (flagSet.Equal(PortFlag::Connectible))
-        {
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-        if (flagSet.Equal(PortFlag::Draging))
-        {
-            drawList->AddCircleFilled(center, radius3, color4);
-        }
-        if (flagSet.Equal(PortFlag::Hovered | PortFlag::Connectible))
-        {
-            drawList->AddCircleFilled(center, radius3, color4);
-        }
-    }
-    else
-    {
-        drawList->AddCircleFilled(center, radius2, color3); // Inner circle
-        if (flagSet.Equal(PortFlag::Hovered))
-        {
-            // drawList->AddRect(rectPort.Min * scale + offset, rectPort.Max * scale + offset, ImColor(1.0f, 0.0f, 0.0f, 0.5f));
-        }
-        if (flagSet.Equal(PortFlag::Connectible))
-        {
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-    }
-}
-
 CoreNodeOutput::CoreNodeOutput(const std::string& name, PortType type, PortDataType dataType) :
     name(name), type(type), dataType(dataType)
 {
     flagSet.SetFlag(PortFlag::Default);
 
-    rectName.Min = ImVec2(0.0f, 0.0f) - ImGui::CalcTextSize(name.c_str());
+    rectName.Min = ImVec2(0.0f, 0.0f) - MeasureText(name);
     rectName.Max = ImVec2(0.0f, 0.0f);
     ref = rectName.GetHeight();
     rectPin = ImRect(ImVec2((kPadding + kPin + kPadding) * ref * -1.0f, kHeight * ref * -1.0f), ImVec2(0.0f, 0.0f));
@@ -234,24 +166,7 @@ CoreNodeOutput::CoreNodeOutput(const std::string& name, PortType type, PortDataT
     rectName.Translate(offset);
 }
 
-void CoreNodeOutput::Save(pugi::xml_node & xmlNode) const
-{
-    auto node = xmlNode.append_child("output");
-    node.append_attribute("name").set_value(name.c_str());
-    SaveImVec2(node, "position", position);
-    SaveFloat(node, "ref", ref);
-    SaveImRect(node, "rectName", rectName);
-    SaveImRect(node, "rectPin", rectPin);
-    SaveImRect(node, "rectPort", rectPort);
-    SaveInt(node, "type", (int)type);
-    SaveInt(node, "dataType", (int)dataType);
-    SaveInt(node, "order", order);
-    SaveInt(node, "flagSet", flagSet.GetInt());
-    SaveInt(node, "linkNum", linkNum);
-    SaveBool(node, "inverted", inverted);
-}
-
-void CoreNodeOutput::Load(const pugi::xml_node & xmlNode)
+void CoreNodeOutput::LoadV1(const pugi::xml_node & xmlNode)
 {
     name = xmlNode.attribute("name").as_string();
     position = LoadImVec2(xmlNode, "position");
@@ -267,6 +182,40 @@ void CoreNodeOutput::Load(const pugi::xml_node & xmlNode)
     inverted = LoadBool(xmlNode, "inverted");
 }
 
+BinaryPort CoreNodeOutput::Save(CoreBinaryWriter& writer) const
+{
+    BinaryPort record;
+    record.name = writer.AddString(name);
+    record.position = ToBinary(position);
+    record.ref = ref;
+    record.rectName = ToBinary(rectName);
+    record.rectPin = ToBinary(rectPin);
+    record.rectPort = ToBinary(rectPort);
+    record.type = (int)type;
+    record.dataType = (int)dataType;
+    record.order = order;
+    record.flagSet = flagSet.GetInt();
+    record.linkNum = linkNum;
+    record.inverted = inverted;
+    return record;
+}
+
+void CoreNodeOutput::Load(const CoreBinaryReader& reader, const BinaryPort& record)
+{
+    name = reader.GetString(record.name);
+    position = FromBinary(record.position);
+    ref = record.ref;
+    rectName = FromBinary(record.rectName);
+    rectPin = FromBinary(record.rectPin);
+    rectPort = FromBinary(record.rectPort);
+    type = (PortType)record.type;
+    dataType = (PortDataType)record.dataType;
+    order = record.order;
+    flagSet.SetInt(record.flagSet);
+    linkNum = record.linkNum;
+    inverted = record.inverted != 0;
+}
+
 void CoreNodeOutput::Translate(ImVec2 delta)
 {
     position += delta;
@@ -291,103 +240,4 @@ void CoreNodeOutput::Invert()
         rectName.Translate(ImVec2(-deltaName, 0.0f));
         inverted = false;
     }
-}
-
-void CoreNodeOutput::Draw(ImDrawList* drawList, ImVec2 offset, float scale) const
-{
-    if (type == PortType::None)
-    {
-        return;
-    }
-
-    ImGui::SetCursorScreenPos((rectName.Min * scale) + offset);
-    ImGui::Text(name.c_str());
-
-    // Show type.
-    if (flagSet.Equal(PortFlag::Draging))
-    {
-        std::string typeName = portTypeNames.at(static_cast<int>(dataType));
-        ImVec2 typeNameSize = ImGui::CalcTextSize(typeName.c_str());
-        auto distText = ImVec2(10.0f, 0.0f);
-        if (inverted == false)
-        {
-            auto point = ImVec2(rectName.Min.x + rectName.GetWidth() + rectPin.GetWidth(), rectName.Min.y) + distText;
-            ImGui::SetCursorScreenPos((point * scale) + offset);
-        }
-        else
-        {
-            auto point = ImVec2(rectName.Min.x - rectPin.GetWidth(), rectName.Min.y) - distText;
-            ImGui::SetCursorScreenPos((point * scale - ImVec2(typeNameSize.x, 0.0f)) + offset);
-        }
-        auto typeColor = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // data type text color
-        ImGui::TextColored(typeColor, typeName.c_str());
-    }
-
-    auto center = ImVec2((position * scale) + offset);
-    auto radius1 = kPin * rectName.GetHeight() * 0.5f * scale;
-    auto radius2 = kPin * rectName.GetHeight() * 0.5f * scale * 0.5f;
-    auto radius3 = kPin * rectName.GetHeight() * 0.5f * scale * 0.8f;
-
-    auto thickness1 = 0.1f * rectName.GetHeight() * scale;
-
-    auto color1 = ImColor(0.000f, 0.459f, 0.388f, 1.0f); // background
-    auto color2 = ImColor(0.341f, 0.659f, 0.769f, 1.0f); // teal ring
-    auto color3 = ImColor(1.000f, 1.000f, 1.000f, 1.0f); // white
-    auto color4 = ImColor(0.996f, 0.431f, 0.000f, 1.0f); // orange
-
-    drawList->AddCircleFilled(center, radius1, color1, 0); // Background
-    drawList->AddCircle(center, radius1, color2, 0, thickness1); // Outer ring
-
-    float distTri = radius1 * 1.6f;
-    float triLength = radius1;
-    if (flagSet.Equal(PortFlag::Draging) && type == PortType::Out)
-    {
-        if (inverted == false)
-        {
-            auto loc = ImVec2(center.x + distTri + radius1, center.y);
-            drawList->AddTriangleFilled(loc + ImVec2(-triLength, triLength), loc + ImVec2(-triLength, -triLength), loc, color4);
-        }
-        else
-        {
-            auto loc = ImVec2(center.x - distTri - radius1, center.y);
-            drawList->AddTriangleFilled(loc + ImVec2(triLength, triLength), loc + ImVec2(triLength, -triLength), loc, color4);
-        }
-    }
-
-    if (linkNum == 0)
-    {
-        if (flagSet.Equal(PortFlag::Hovered))
-        {
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-        if (flagSet.Equal(PortFlag::Connectible))
-        {
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-        if (flagSet.Equal(PortFlag::Draging))
-        {
-            drawList->AddCircleFilled(center, radius3, color4);
-        }
-        if (flagSet.Equal(PortFlag::Hovered | PortFlag::Connectible))
-        {
-            drawList->AddCircleFilled(center, radius3, color4);
-        }
-    }
-    else
-    {
-        drawList->AddCircleFilled(center, radius2, color3); // Inner circle
-        if (flagSet.Equal(PortFlag::Hovered))
-        {
-            // drawList->AddRect(rectPort.Min * scale + offset, rectPort.Max * scale + offset, ImColor(1.0f, 0.0f, 0.0f, 0.5f));
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-        if (flagSet.Equal(PortFlag::Draging))
-        {
-            drawList->AddCircleFilled(center, radius3, color4);
-        }
-        if (flagSet.Equal(PortFlag::Connectible))
-        {
-            drawList->AddCircleFilled(center, radius2, color4);
-        }
-    }
 }
\ No newline at end of file
@@ -12,7 +12,7 @@
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <bitset>
-#include "FileDialog.hpp"
+#include "CoreBinary.hpp"
 
 const std::vector<std::string> portTypeNames
 {
@@ -71,6 +71,12 @@ struct PortFlag
     static const unsigned int Draging = 1 << 3;
 };
 
+// Text size used for the node geometry. The application sets it to the size measured with its font.
+// Projects are loaded on several threads, the function must only read shared state.
+using TextSizeFunc = ImVec2 (*)(const std::string& text);
+void SetTextSizeFunc(TextSizeFunc func);
+ImVec2 MeasureText(const std::string& text);
+
 class CoreNode;
 class CoreNodeOutput;
 class CoreNodeInput
@@ -101,10 +107,11 @@ public:
     CoreNodeInput() = default;
     CoreNodeInput(const std::string& name, PortType type, PortDataType dataType);
     virtual ~CoreNodeInput() = default;
-    void Save(pugi::xml_node& xmlNode) const;
-    void Load(const pugi::xml_node& xmlNode);
+    void LoadV1(const pugi::xml_node& xmlNode);
+    BinaryPort Save(CoreBinaryWriter& writer) const;
+    void Load(const CoreBinaryReader& reader, const BinaryPort& record);
 
-    std::string GetName() const { return name; }
+    const std::string& GetName() const { return name; }
     PortType GetType() const { return type; };
     PortDataType GetDataType() const { return dataType; };
     int GetOrder() const { return order; }
@@ -130,6 +137,8 @@ public:
     int GetTargetLinkSep() const { return targetLinkSep; }
     void Translate(ImVec2 delta);
     void Draw(ImDrawList* drawList, ImVec2 offset, float scale) const;
+    void DrawPin(ImDrawList* drawList, ImVec2 offset, float scale) const; // Low detail, no text.
+    unsigned long long GetDrawSignature(unsigned long long hash) const;
     void Invert();
 };
 
@@ -155,10 +164,11 @@ public:
     CoreNodeOutput() = default;
     CoreNodeOutput(const std::string& name, PortType type, PortDataType dataType);
     virtual ~CoreNodeOutput() = default;
-    void Save(pugi::xml_node& xmlNode) const;
-    void Load(const pugi::xml_node& xmlNode);
+    void LoadV1(const pugi::xml_node& xmlNode);
+    BinaryPort Save(CoreBinaryWriter& writer) const;
+    void Load(const CoreBinaryReader& reader, const BinaryPort& record);
 
-    std::string GetName() const { return name; }
+    const std::string& GetName() const { return name; }
     PortType GetType() const { return type; };
     PortDataType GetDataType() const { return dataType; };
     int GetOrder() const { return order; }
@@ -172,6 +182,8 @@ public:
     void DecreaseLinkNum() { linkNum > 0 ? linkNum -= 1 : linkNum = 0; }
     void Translate(ImVec2 delta);
     void Draw(ImDrawList* drawList, ImVec2 offset, float scale) const;
+    void DrawPin(ImDrawList* drawList, ImVec2 offset, float scale) const; // Low detail, no text.
+    unsigned long long GetDrawSignature(unsigned long long hash) const;
     void Invert();
 };
 
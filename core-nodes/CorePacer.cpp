@@ -0,0 +1,90 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Pacer                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CorePacer.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+std::int64_t CorePacer::Now()
+{
+#if defined(__linux__)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void CorePacer::SleepUntil(std::int64_t deadline)
+{
+#if defined(__linux__)
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline / 1000000000);
+    ts.tv_nsec = static_cast<long>(deadline % 1000000000);
+    int result = 0;
+    do
+    {
+        result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+    } while (result == EINTR); // Interrupted by a signal, the deadline is absolute so just sleep again.
+    // Other errors return at once, the caller reads the clock and spins to the deadline.
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline)));
+#endif
+}
+
+void CorePacer::Start(double simTimeScale)
+{
+    timeScale = simTimeScale;
+    stats = PacerStats();
+    startNs = Now();
+}
+
+bool CorePacer::WaitUntil(double simTime, const std::atomic<bool>& cancel)
+{
+    const auto deadline = startNs + static_cast<std::int64_t>(std::llround(simTime / timeScale * 1e9));
+    std::int64_t now = Now();
+    if (now > deadline)
+    {
+        stats.overruns += 1;
+        Record((now - deadline) * 1e-9);
+        return true;
+    }
+    while (deadline - now > spinNs)
+    {
+        if (cancel.load(std::memory_order_relaxed) == true)
+        {
+            return false;
+        }
+        SleepUntil(std::min(deadline - spinNs, now + sliceNs));
+        now = Now();
+    }
+    while (now < deadline)
+    {
+        now = Now();
+    }
+    Record((now - deadline) * 1e-9);
+    return true;
+}
+
+void CorePacer::Record(double late)
+{
+    stats.samples += 1;
+    stats.lateness = late;
+    stats.latenessMax = std::max(stats.latenessMax, late);
+    auto bin = std::upper_bound(stats.binEdges.begin(), stats.binEdges.end(), late) - stats.binEdges.begin();
+    stats.histogram[bin] += 1;
+}
\ No newline at end of file
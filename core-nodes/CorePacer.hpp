@@ -0,0 +1,52 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Pacer                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREPACER_HPP
+#define COREPACER_HPP
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+struct PacerStats
+{
+    static constexpr int binNum = 8;
+    static constexpr std::array<double, binNum - 1> binEdges{ 10e-6, 50e-6, 100e-6, 500e-6, 1e-3, 5e-3, 10e-3 }; // Lateness [s].
+    long long samples = 0;
+    long long overruns = 0;             // Samples computed after their deadline.
+    double lateness = 0.0;              // Of the last sample [s].
+    double latenessMax = 0.0;
+    std::array<long long, binNum> histogram{};
+};
+
+// Holds the simulation to the wall clock. Deadlines are absolute, measured from Start,
+// so that a late sample never shifts the following ones and the run does not drift.
+class CorePacer
+{
+private:
+    std::int64_t startNs = 0;
+    double timeScale = 1.0;             // Simulation seconds per wall second.
+    std::int64_t spinNs = 200000;       // The last part of a wait is spent spinning, sleeps overshoot.
+    std::int64_t sliceNs = 20000000;    // Longest sleep between checks of the cancel flag.
+    PacerStats stats;
+    static std::int64_t Now();
+    static void SleepUntil(std::int64_t deadline);
+    void Record(double late);
+
+public:
+    CorePacer() = default;
+    virtual ~CorePacer() = default;
+    void Start(double simTimeScale);
+
+    // Waits until the wall clock catches up with the given simulation time. Returns false if canceled.
+    bool WaitUntil(double simTime, const std::atomic<bool>& cancel);
+    const PacerStats& GetStats() const { return stats; }
+};
+
+#endif /* COREPACER_HPP */
\ No newline at end of file
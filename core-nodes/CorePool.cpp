@@ -0,0 +1,147 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Pool                                                                            *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CorePool.hpp"
+#include <algorithm>
+
+CorePool::CorePool(int threadNum)
+{
+    if (threadNum <= 0)
+    {
+        threadNum = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threadNum; i++)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < threadNum; i++)
+    {
+        threads.emplace_back(&CorePool::Work, this, i);
+    }
+}
+
+CorePool::~CorePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    cvStart.notify_all();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void CorePool::ParallelFor(long long count, const Job& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    // One contiguous block per worker to start with, stealing balances the rest.
+    const auto threadNum = static_cast<long long>(threads.size());
+    for (long long i = 0; i < threadNum; i++)
+    {
+        const Range range{ count * i / threadNum, count * (i + 1) / threadNum };
+        if (range.end > range.begin)
+        {
+            Push(static_cast<int>(i), range);
+        }
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    job = &func;
+    remaining.store(count, std::memory_order_relaxed);
+    active = static_cast<int>(threads.size());
+    generation += 1;
+    cvStart.notify_all();
+    cvDone.wait(lock, [this]() { return active == 0; });
+    job = nullptr;
+}
+
+void CorePool::Work(int worker)
+{
+    long long seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cvStart.wait(lock, [&]() { return quit == true || generation != seen; });
+            if (quit == true)
+            {
+                return;
+            }
+            seen = generation;
+        }
+        Drain(worker);
+        std::lock_guard<std::mutex> lock(mutex);
+        active -= 1;
+        if (active == 0)
+        {
+            cvDone.notify_all();
+        }
+    }
+}
+
+void CorePool::Drain(int worker)
+{
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        Range range;
+        if (Pop(worker, range) == false && Steal(worker, range) == false)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        // Keep the first index, leave the rest to be split further or stolen.
+        while (range.end - range.begin > 1)
+        {
+            const long long mid = range.begin + (range.end - range.begin) / 2;
+            Push(worker, Range{ mid, range.end });
+            range.end = mid;
+        }
+        (*job)(range.begin, worker);
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void CorePool::Push(int worker, const Range& range)
+{
+    std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+    queues[worker]->ranges.push_back(range);
+}
+
+bool CorePool::Pop(int worker, Range& range)
+{
+    std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+    if (queues[worker]->ranges.empty() == true)
+    {
+        return false;
+    }
+    range = queues[worker]->ranges.back();
+    queues[worker]->ranges.pop_back();
+    return true;
+}
+
+bool CorePool::Steal(int worker, Range& range)
+{
+    const int threadNum = static_cast<int>(queues.size());
+    for (int i = 1; i < threadNum; i++)
+    {
+        Queue& victim = *queues[(worker + i) % threadNum];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.ranges.empty() == false)
+        {
+            range = victim.ranges.front();
+            victim.ranges.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Pool                                                                            *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREPOOL_HPP
+#define COREPOOL_HPP
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Work-stealing thread pool for independent jobs. Each worker splits index ranges off its own
+// deque and runs them back to front; idle workers steal the largest ranges from the front of the others.
+class CorePool
+{
+public:
+    using Job = std::function<void(long long index, int worker)>;
+
+private:
+    struct Range
+    {
+        long long begin;
+        long long end;
+    };
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::mutex mutex;
+    std::condition_variable cvStart;
+    std::condition_variable cvDone;
+    long long generation = 0;
+    int active = 0;
+    bool quit = false;
+    const Job* job = nullptr;
+    std::atomic<long long> remaining{ 0 };
+    void Work(int worker);
+    void Drain(int worker);
+    void Push(int worker, const Range& range);
+    bool Pop(int worker, Range& range);
+    bool Steal(int worker, Range& range);
+
+public:
+    explicit CorePool(int threadNum = 0); // Zero uses every hardware thread.
+    CorePool(const CorePool&) = delete;
+    CorePool& operator=(const CorePool&) = delete;
+    virtual ~CorePool();
+    int GetThreadNum() const { return static_cast<int>(threads.size()); }
+
+    // Runs job(i, worker) for every i in [0, count) and returns when all of them are done.
+    void ParallelFor(long long count, const Job& func);
+};
+
+#endif /* COREPOOL_HPP */
\ No newline at end of file
@@ -0,0 +1,230 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Program                                                                         *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreProgram.hpp"
+#include "CoreNode.hpp"
+#include <unordered_map>
+#include <algorithm>
+
+void CoreProgram::Clear()
+{
+    steps.clear();
+    stateSteps.clear();
+    stateNum = 0;
+    inputIndex.clear();
+    signals.clear();
+    params.clear();
+    signalNames.clear();
+    paramNames.clear();
+    error.clear();
+}
+
+bool CoreProgram::Compile(const std::vector<CoreNode*>& exeOrder)
+{
+    Clear();
+
+    // Assign an arena slot to every output first, so that inputs can refer to any node.
+    std::unordered_map<const CoreNodeOutput*, int> outputSlot;
+    signalNames.emplace_back("zero");
+    for (const auto& node : exeOrder)
+    {
+        for (const auto& output : node->GetOutputVec())
+        {
+            outputSlot[&output] = static_cast<int>(signalNames.size());
+            signalNames.push_back(node->GetName() + "." + output.GetName());
+        }
+    }
+    signals.assign(signalNames.size(), 0.0);
+
+    int out = 1;
+    for (const auto& node : exeOrder)
+    {
+        NodeKernel kernel;
+        node->Compile(kernel);
+        if (kernel.output != nullptr || kernel.derivative != nullptr)
+        {
+            Step step;
+            step.output = kernel.output;
+            step.derivative = kernel.derivative;
+            step.init = kernel.init;
+            step.in = static_cast<int>(inputIndex.size());
+            step.out = out;
+            step.param = static_cast<int>(params.size());
+            step.x = stateNum;
+            step.inNum = static_cast<int>(node->GetInputVec().size());
+            step.outNum = static_cast<int>(node->GetOutputVec().size());
+            step.xNum = kernel.stateNum;
+            step.feedthrough = kernel.feedthrough;
+            stateNum += kernel.stateNum;
+            for (const auto& input : node->GetInputVec())
+            {
+                int slot = 0; // Unconnected input reads the zero signal.
+                if (input.GetTargetNodeOutput() != nullptr)
+                {
+                    auto it = outputSlot.find(input.GetTargetNodeOutput());
+                    if (it == outputSlot.end())
+                    {
+                        Clear();
+                        error = "\"" + node->GetName() + "." + input.GetName() + "\" is linked to a node out of the execution order.";
+                        return false;
+                    }
+                    slot = it->second;
+                }
+                inputIndex.push_back(slot);
+            }
+            if (kernel.paramName.size() != kernel.param.size())
+            {
+                Clear();
+                error = "\"" + node->GetName() + "\" does not name each of its parameters.";
+                return false;
+            }
+            params.insert(params.end(), kernel.param.begin(), kernel.param.end());
+            for (const auto& paramName : kernel.paramName)
+            {
+                paramNames.push_back(node->GetName() + "." + paramName);
+            }
+            if (step.derivative != nullptr)
+            {
+                stateSteps.push_back(static_cast<int>(steps.size()));
+            }
+            steps.push_back(step);
+        }
+        out += static_cast<int>(node->GetOutputVec().size());
+    }
+    return true;
+}
+
+void CoreProgram::Initialize(double t, double* x)
+{
+    // Initial states may depend on upstream outputs (Ic ports), so states are set in execution order.
+    // The arena is cleared first, a run never reads the signals of the previous one.
+    std::fill(signals.begin(), signals.end(), 0.0);
+    StepArgs args;
+    args.signals = signals.data();
+    args.t = t;
+    for (const auto& step : steps)
+    {
+        args.in = inputIndex.data() + step.in;
+        args.out = signals.data() + step.out;
+        args.param = params.data() + step.param;
+        args.x = x + step.x;
+        if (step.init != nullptr)
+        {
+            step.init(args);
+        }
+        if (step.output != nullptr)
+        {
+            step.output(args);
+        }
+    }
+}
+
+void CoreProgram::Outputs(double t, double* x)
+{
+    StepArgs args;
+    args.signals = signals.data();
+    args.t = t;
+    for (const auto& step : steps)
+    {
+        if (step.output != nullptr)
+        {
+            args.in = inputIndex.data() + step.in;
+            args.out = signals.data() + step.out;
+            args.param = params.data() + step.param;
+            args.x = x + step.x;
+            step.output(args);
+        }
+    }
+}
+
+void CoreProgram::Derivatives(double t, double* x, double* dx)
+{
+    Outputs(t, x);
+    StepArgs args;
+    args.signals = signals.data();
+    args.t = t;
+    for (const auto& i : stateSteps)
+    {
+        const Step& step = steps[i];
+        args.in = inputIndex.data() + step.in;
+        args.out = signals.data() + step.out;
+        args.param = params.data() + step.param;
+        args.x = x + step.x;
+        args.dx = dx + step.x;
+        step.derivative(args);
+    }
+}
+
+void CoreProgram::JacobianPattern(SparsePattern& pattern) const
+{
+    // States each signal depends on, propagated along the execution order.
+    std::vector<std::vector<int>> signalDeps(signals.size());
+    auto inputDeps = [&](const Step& step)
+    {
+        std::vector<int> deps;
+        for (int i = 0; i < step.inNum; i++)
+        {
+            const auto& d = signalDeps[inputIndex[step.in + i]];
+            deps.insert(deps.end(), d.begin(), d.end());
+        }
+        for (int i = 0; i < step.xNum; i++)
+        {
+            deps.push_back(step.x + i);
+        }
+        std::sort(deps.begin(), deps.end());
+        deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+        return deps;
+    };
+    for (const auto& step : steps)
+    {
+        std::vector<int> deps;
+        if (step.feedthrough == true)
+        {
+            deps = inputDeps(step);
+        }
+        else
+        {
+            for (int i = 0; i < step.xNum; i++)
+            {
+                deps.push_back(step.x + i);
+            }
+        }
+        for (int i = 0; i < step.outNum; i++)
+        {
+            signalDeps[step.out + i] = deps;
+        }
+    }
+
+    // Derivatives are evaluated after all outputs, so they may depend on any signal.
+    std::vector<std::vector<int>> stateDeps(stateNum);
+    for (const auto& i : stateSteps)
+    {
+        const Step& step = steps[i];
+        const std::vector<int> deps = inputDeps(step);
+        for (int j = 0; j < step.xNum; j++)
+        {
+            stateDeps[step.x + j] = deps;
+        }
+    }
+
+    pattern.n = stateNum;
+    pattern.rowPtr.assign(1, 0);
+    pattern.col.clear();
+    for (const auto& deps : stateDeps)
+    {
+        pattern.col.insert(pattern.col.end(), deps.begin(), deps.end());
+        pattern.rowPtr.push_back(static_cast<int>(pattern.col.size()));
+    }
+}
+
+int CoreProgram::FindParam(const std::string& name) const
+{
+    auto it = std::find(paramNames.begin(), paramNames.end(), name);
+    return it == paramNames.end() ? -1 : static_cast<int>(it - paramNames.begin());
+}
\ No newline at end of file
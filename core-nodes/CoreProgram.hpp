@@ -0,0 +1,94 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Program                                                                         *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREPROGRAM_HPP
+#define COREPROGRAM_HPP
+
+#include <vector>
+#include <string>
+#include "CoreSparse.hpp"
+
+// Arguments of a single step. Inputs are indices into the signal arena.
+struct StepArgs
+{
+    const double* signals = nullptr;    // Signal arena.
+    const int* in = nullptr;            // Arena index of each input.
+    double* out = nullptr;              // Output slots of the node.
+    const double* param = nullptr;      // Parameters of the node.
+    double* x = nullptr;                // Continuous states of the node.
+    double* dx = nullptr;               // State derivatives of the node.
+    double t = 0.0;                     // Simulation time.
+    double In(int i) const { return signals[in[i]]; }
+    bool IsLinked(int i) const { return in[i] != 0; }
+};
+using StepFunc = void (*)(const StepArgs& args);
+
+// What a node contributes to the compiled program.
+struct NodeKernel
+{
+    StepFunc output = nullptr;          // Computes the outputs from the inputs and states.
+    StepFunc derivative = nullptr;      // Computes the state derivatives.
+    StepFunc init = nullptr;            // Sets the initial states.
+    int stateNum = 0;
+    bool feedthrough = true;            // Outputs depend on the inputs directly, not only through the states.
+    std::vector<double> param;          // Copied into the parameter arena.
+    std::vector<std::string> paramName; // Name of each parameter, as listed by GetParams.
+};
+
+class CoreNode;
+class CoreProgram
+{
+private:
+    struct Step
+    {
+        StepFunc output;
+        StepFunc derivative;
+        StepFunc init;
+        int in;         // First entry in inputIndex.
+        int out;        // First output slot in signals.
+        int param;      // First entry in params.
+        int x;          // First entry in the state vector.
+        int inNum;
+        int outNum;
+        int xNum;
+        bool feedthrough;
+    };
+    std::vector<Step> steps;            // Flat instruction array, in execution order.
+    std::vector<int> stateSteps;        // Steps with a derivative function.
+    int stateNum = 0;
+    std::vector<int> inputIndex;        // Arena index of every input, step by step.
+    std::vector<double> signals;        // Signal arena. Slot 0 is the zero signal of unconnected inputs.
+    std::vector<double> params;         // Parameter arena.
+    std::vector<std::string> signalNames;
+    std::vector<std::string> paramNames; // "Node.param", in arena order.
+    std::string error;
+
+public:
+    CoreProgram() = default;
+    virtual ~CoreProgram() = default;
+    bool Compile(const std::vector<CoreNode*>& exeOrder);
+    void Clear();
+    void Initialize(double t, double* x);
+    void Outputs(double t, double* x);
+    void Derivatives(double t, double* x, double* dx);
+    void JacobianPattern(SparsePattern& pattern) const;
+
+    std::string GetError() const { return error; }
+    int GetStepNum() const { return static_cast<int>(steps.size()); }
+    int GetSignalNum() const { return static_cast<int>(signals.size()); }
+    int GetStateNum() const { return stateNum; }
+    const std::vector<double>& GetSignals() const { return signals; }
+    const std::string& GetSignalName(int i) const { return signalNames.at(i); }
+    int GetParamNum() const { return static_cast<int>(params.size()); }
+    int FindParam(const std::string& name) const;
+    double GetParam(int i) const { return params.at(i); }
+    void SetParam(int i, double value) { params.at(i) = value; }
+};
+
+#endif /* COREPROGRAM_HPP */
\ No newline at end of file
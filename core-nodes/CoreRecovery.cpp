@@ -0,0 +1,508 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Recovery                                                                        *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreRecovery.hpp"
+#include "CoreWriter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+static const char recoveryMagic[8] = { 'D', 'X', 'D', 'T', 'R', 'E', 'C', '1' };
+
+static uint32_t Checksum(char type, const std::string& data)
+{
+    // FNV-1a, enough to find an entry cut short.
+    uint32_t hash = 2166136261u;
+    auto add = [&hash](unsigned char c) { hash = (hash ^ c) * 16777619u; };
+    add(static_cast<unsigned char>(type));
+    for (const char c : data)
+    {
+        add(static_cast<unsigned char>(c));
+    }
+    return hash;
+}
+
+// Size of the data, type, data, checksum.
+static std::string Frame(CoreRecovery::EntryType type, const std::string& data)
+{
+    RecoveryRecord entry;
+    entry.Put(static_cast<uint32_t>(data.size()));
+    entry.Put(static_cast<char>(type));
+    std::string frame = entry.GetData() + data;
+    const uint32_t sum = Checksum(static_cast<char>(type), data);
+    frame.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+    return frame;
+}
+
+static void GetStamp(const std::string& filePath, uint64_t& size, int64_t& time);
+
+// Path of the project file, then its size and time.
+static std::string GetHeader(const std::string& basePath)
+{
+    RecoveryRecord header;
+    header.PutString(basePath);
+    uint64_t size = 0;
+    int64_t time = 0;
+    GetStamp(basePath, size, time);
+    header.Put(size);
+    header.Put(time);
+    return header.GetData();
+}
+
+static void GetStamp(const std::string& filePath, uint64_t& size, int64_t& time)
+{
+    std::error_code code;
+    size = 0;
+    time = 0;
+    if (filePath.empty() == true || std::filesystem::exists(filePath, code) == false)
+    {
+        return;
+    }
+    size = static_cast<uint64_t>(std::filesystem::file_size(filePath, code));
+    time = static_cast<int64_t>(std::filesystem::last_write_time(filePath, code).time_since_epoch().count());
+}
+
+static std::filesystem::path GetIndexDirectory()
+{
+    // Per user, it outlives a restart of the machine.
+#if defined(_WIN32)
+    const char* local = std::getenv("LOCALAPPDATA");
+    if (local != nullptr && local[0] != '\0')
+    {
+        return std::filesystem::path(local) / "core-nodes" / "recovery";
+    }
+#else
+    const char* state = std::getenv("XDG_STATE_HOME");
+    if (state != nullptr && state[0] != '\0')
+    {
+        return std::filesystem::path(state) / "core-nodes" / "recovery";
+    }
+    const char* home = std::getenv("HOME");
+    if (home != nullptr && home[0] != '\0')
+    {
+        return std::filesystem::path(home) / ".local" / "state" / "core-nodes" / "recovery";
+    }
+#endif
+    return std::filesystem::path();
+}
+
+// One small file per open journal, holding its path.
+static void Index(const std::string& journalPath, bool add)
+{
+    const std::filesystem::path directory = GetIndexDirectory();
+    if (directory.empty() == true || journalPath.empty() == true)
+    {
+        return;
+    }
+    std::ostringstream name;
+    name << std::hex << std::hash<std::string>()(std::filesystem::absolute(journalPath).string()) << ".journal";
+    std::error_code code;
+    if (add == false)
+    {
+        std::filesystem::remove(directory / name.str(), code);
+        return;
+    }
+    std::filesystem::create_directories(directory, code);
+    std::ofstream stream(directory / name.str(), std::ios::trunc);
+    stream << std::filesystem::absolute(journalPath).string();
+}
+
+void RecoveryRecord::PutString(const std::string& str)
+{
+    Put(static_cast<uint32_t>(str.size()));
+    data += str;
+}
+
+std::string RecoveryRecord::GetString()
+{
+    const uint32_t size = Get<uint32_t>();
+    if (valid == false || data.size() - position < size)
+    {
+        valid = false;
+        return std::string();
+    }
+    std::string str = data.substr(position, size);
+    position += size;
+    return str;
+}
+
+CoreRecovery::~CoreRecovery()
+{
+    Stop(); // The journal stays for the next start, Close removes it.
+}
+
+void CoreRecovery::Stop()
+{
+    if (worker.joinable() == true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+    if (file != nullptr)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool CoreRecovery::Start(const std::string& recoveryPath, const std::string& basePath, const std::string& entries)
+{
+    if (marked == true && file != nullptr && entries.empty() == true)
+    {
+        return Rebase(recoveryPath, basePath);
+    }
+    Stop();
+    const std::string previous = path;
+    path = recoveryPath;
+    error.clear();
+    Unmark();
+
+    std::string contents(recoveryMagic, sizeof(recoveryMagic));
+    contents += Frame(EntryType::Header, GetHeader(basePath));
+    if (entries.empty() == false)
+    {
+        // Recovered entries are written whole and renamed, the journal they come from stays valid until then.
+        contents += entries;
+        if (CoreWriter::WriteFile(path, contents, error) == false)
+        {
+            return false;
+        }
+        contents.clear();
+    }
+    file = std::fopen(path.c_str(), entries.empty() == true ? "wb" : "ab");
+    if (file == nullptr)
+    {
+        error = "Cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    if (previous.empty() == false && previous != path)
+    {
+        std::error_code code;
+        std::filesystem::remove(previous, code);
+        Index(previous, false);
+    }
+    Index(path, true);
+    pending = std::move(contents);          // A new journal has nothing to lose yet, the worker writes it.
+    quit = false;
+    worker = std::thread(&CoreRecovery::Work, this);
+    return true;
+}
+
+bool CoreRecovery::Rebase(const std::string& recoveryPath, const std::string& basePath)
+{
+    // The save marked in the journal is done. The journal goes on, next to the file written.
+    Unmark();
+    if (recoveryPath != path)
+    {
+        Stop();
+        std::error_code code;
+        std::filesystem::rename(path, recoveryPath, code);
+        if (code)
+        {
+            return Start(recoveryPath, basePath); // Without the history, the journal left behind is removed.
+        }
+        Index(path, false);
+        path = recoveryPath;
+        Index(path, true);
+        file = std::fopen(path.c_str(), "ab");
+        if (file == nullptr)
+        {
+            error = "Cannot open " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        quit = false;
+        worker = std::thread(&CoreRecovery::Work, this);
+    }
+    Append(EntryType::Header, GetHeader(basePath));
+    return true;
+}
+
+void CoreRecovery::Mark()
+{
+    Append(EntryType::Save, std::string());
+    marked = true;
+}
+
+void CoreRecovery::Close()
+{
+    Stop();
+    Unmark();
+    if (path.empty() == false)
+    {
+        std::error_code code;
+        std::filesystem::remove(path, code);
+        Index(path, false);
+        path.clear();
+    }
+}
+
+void CoreRecovery::CommandRecorded(const CoreCommand& command)
+{
+    if (file == nullptr)
+    {
+        return;
+    }
+    RecoveryRecord record;
+    command.Write(record);
+    Append(EntryType::Command, record.GetData());
+}
+
+void CoreRecovery::Append(EntryType type, const std::string& data)
+{
+    if (file == nullptr)
+    {
+        return;
+    }
+    const std::string frame = Frame(type, data);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending += frame;
+    }
+    wake.notify_one();
+}
+
+std::string CoreRecovery::GetError() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+void CoreRecovery::Work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this] { return quit == true || pending.empty() == false; });
+        if (pending.empty() == true)
+        {
+            return;
+        }
+        // The entries added during the previous sync go out together.
+        std::string batch;
+        batch.swap(pending);
+        lock.unlock();
+        bool ok = std::fwrite(batch.data(), 1, batch.size(), file) == batch.size();
+        ok = ok && CoreWriter::FlushFile(file) == true;
+        lock.lock();
+        if (ok == false && error.empty() == true)
+        {
+            error = "Cannot write " + path + ": " + std::strerror(errno);
+        }
+    }
+}
+
+std::vector<std::string> CoreRecovery::FindJournals()
+{
+    std::vector<std::string> journals;
+    auto add = [&journals](const std::filesystem::path& journal)
+    {
+        const std::string journalPath = std::filesystem::absolute(journal).string();
+        if (std::find(journals.begin(), journals.end(), journalPath) == journals.end())
+        {
+            journals.push_back(journalPath);
+        }
+    };
+    std::error_code code;
+    const std::filesystem::path directory = GetIndexDirectory();
+    if (directory.empty() == false)
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(directory, code))
+        {
+            std::string journalPath;
+            std::getline(std::ifstream(entry.path()), journalPath);
+            if (std::filesystem::exists(journalPath, code) == true)
+            {
+                add(journalPath);
+            }
+            else
+            {
+                std::filesystem::remove(entry.path(), code); // Recovered or declined.
+            }
+        }
+    }
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path(), code))
+    {
+        if (entry.path().extension() == ".recovery")
+        {
+            add(entry.path());
+        }
+    }
+    return journals;
+}
+
+void CoreRecovery::Rebase(std::vector<Entry>& entries, long long base)
+{
+    // The entries before the save are in the project file. They are followed through a journal of
+    // their bytes and turned into the history the replay records without applying.
+    std::vector<Entry> rebased;
+    if (base >= 0)
+    {
+        std::vector<std::vector<std::string>> steps;
+        std::vector<std::string> pending;
+        size_t current = 0;
+        auto commit = [&]()
+        {
+            if (pending.empty() == false)
+            {
+                steps.resize(current);
+                steps.push_back(std::move(pending));
+                pending.clear();
+                current += 1;
+            }
+        };
+        for (long long i = 0; i < base; i++)
+        {
+            Entry& entry = entries[i];
+            if (entry.type == EntryType::Command || entry.type == EntryType::History)
+            {
+                pending.push_back(std::move(entry.data));
+            }
+            else if (entry.type == EntryType::Commit)
+            {
+                commit();
+            }
+            else if (entry.type == EntryType::Base)
+            {
+                RecoveryRecord record(std::move(entry.data));
+                current = std::min(static_cast<size_t>(record.Get<uint64_t>()), steps.size());
+            }
+            else if (entry.type == EntryType::Undo)
+            {
+                commit();
+                current -= current > 0 ? 1 : 0;
+            }
+            else if (entry.type == EntryType::Redo && pending.empty() == true && current < steps.size())
+            {
+                current += 1;
+            }
+        }
+        for (auto& step : steps)
+        {
+            for (auto& command : step)
+            {
+                rebased.push_back(Entry{ EntryType::History, std::move(command) });
+            }
+            rebased.push_back(Entry{ EntryType::Commit, std::string() });
+        }
+        RecoveryRecord record;
+        record.Put(static_cast<uint64_t>(current));
+        rebased.push_back(Entry{ EntryType::Base, record.GetData() });
+        for (auto& command : pending)
+        {
+            rebased.push_back(Entry{ EntryType::History, std::move(command) });
+        }
+    }
+    for (size_t i = static_cast<size_t>(base + 1); i < entries.size(); i++)
+    {
+        if (entries[i].type != EntryType::Save) // Saves that failed or did not finish.
+        {
+            rebased.push_back(std::move(entries[i]));
+        }
+    }
+    entries = std::move(rebased);
+}
+
+bool CoreRecovery::Read(const std::string& recoveryPath, std::string& basePath, std::vector<Entry>& entries, std::string& data, std::string& error)
+{
+    entries.clear();
+    data.clear();
+    std::ifstream stream(recoveryPath, std::ios::binary);
+    if (stream.is_open() == false)
+    {
+        error = "Cannot open " + recoveryPath;
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << stream.rdbuf();
+    const std::string contents = buffer.str();
+    if (contents.size() < sizeof(recoveryMagic) || std::memcmp(contents.data(), recoveryMagic, sizeof(recoveryMagic)) != 0)
+    {
+        error = "Not a recovery journal.";
+        return false;
+    }
+
+    bool hasHeader = false;
+    uint64_t baseSize = 0;
+    int64_t baseTime = 0;
+    long long lastSave = -1;
+    long long base = -1;                    // Save entry of the project file.
+    size_t offset = sizeof(recoveryMagic);
+    const size_t frameSize = sizeof(uint32_t) + 1 + sizeof(uint32_t);
+    while (contents.size() - offset >= frameSize)
+    {
+        uint32_t size = 0;
+        std::memcpy(&size, contents.data() + offset, sizeof(size));
+        if (contents.size() - offset - frameSize < size)
+        {
+            break;
+        }
+        const char type = contents[offset + sizeof(uint32_t)];
+        std::string entryData = contents.substr(offset + sizeof(uint32_t) + 1, size);
+        uint32_t sum = 0;
+        std::memcpy(&sum, contents.data() + offset + sizeof(uint32_t) + 1 + size, sizeof(sum));
+        if (sum != Checksum(type, entryData))
+        {
+            break;
+        }
+        if (type == static_cast<char>(EntryType::Header))
+        {
+            // The first header, or a save that is done.
+            RecoveryRecord header(std::move(entryData));
+            std::string headerPath = header.GetString();
+            const uint64_t headerSize = header.Get<uint64_t>();
+            const int64_t headerTime = header.Get<int64_t>();
+            if (header.IsValid() == false || hasHeader != (lastSave >= 0))
+            {
+                break;
+            }
+            basePath = std::move(headerPath);
+            baseSize = headerSize;
+            baseTime = headerTime;
+            base = lastSave;
+            hasHeader = true;
+        }
+        else if (hasHeader == false)
+        {
+            break;
+        }
+        else
+        {
+            lastSave = type == static_cast<char>(EntryType::Save) ? static_cast<long long>(entries.size()) : lastSave;
+            entries.push_back(Entry{ static_cast<EntryType>(type), std::move(entryData) });
+        }
+        offset += frameSize + size;
+    }
+    if (hasHeader == false)
+    {
+        error = "The recovery journal has no header.";
+        return false;
+    }
+    uint64_t size = 0;
+    int64_t time = 0;
+    GetStamp(basePath, size, time);
+    if (size != baseSize || time != baseTime)
+    {
+        error = "The project file " + basePath + " has changed since the recovery journal was written.";
+        return false;
+    }
+    Rebase(entries, base);
+    for (const auto& entry : entries)
+    {
+        data += Frame(entry.type, entry.data);
+    }
+    return true;
+}
\ No newline at end of file
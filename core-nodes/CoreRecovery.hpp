@@ -0,0 +1,124 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Recovery                                                                        *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORERECOVERY_HPP
+#define CORERECOVERY_HPP
+
+#include "CoreJournal.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Fields of a recovery entry, read back in the order they were written, in the byte order of the machine.
+class RecoveryRecord
+{
+private:
+    std::string data;
+    size_t position = 0;
+    bool valid = true;
+
+public:
+    RecoveryRecord() = default;
+    explicit RecoveryRecord(std::string bytes) : data(std::move(bytes)) {}
+    virtual ~RecoveryRecord() = default;
+    const std::string& GetData() const { return data; }
+    bool IsValid() const { return valid; }  // False once a read went past the end.
+
+    template<typename T>
+    void Put(T value) { data.append(reinterpret_cast<const char*>(&value), sizeof(T)); }
+    void PutString(const std::string& str);
+    template<typename T>
+    T Get()
+    {
+        T value{};
+        if (valid == false || data.size() - position < sizeof(T))
+        {
+            valid = false;
+            return value;
+        }
+        std::memcpy(&value, data.data() + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+    std::string GetString();
+};
+
+// Append-only journal of the edits made since the project file was written, kept next to it. The
+// editor hands each entry over in microseconds, a worker writes and syncs what has piled up in one
+// batch. After a crash the entries are replayed on top of the project file. Each entry carries a
+// checksum, an entry cut by the crash ends the journal. A save adds two entries and the journal
+// goes on, the entries before the save become the history when the journal is read. Each open
+// journal leaves its path in a directory of the user, so the next start finds it.
+// Every member is called from the UI thread.
+class CoreRecovery : public JournalObserver
+{
+public:
+    enum class EntryType : char
+    {
+        Header = 'H',                       // Path of the project file, then its size and time. Again when a save is done.
+        Command = 'C',                      // Applied when replayed.
+        History = 'P',                      // Already in the project file, only recorded.
+        Commit = 'S',
+        Base = 'B',                         // Steps applied in the project file.
+        Undo = 'U',
+        Redo = 'R',
+        Save = 'V'                          // The project file was snapshot, the next header is the file written.
+    };
+    struct Entry
+    {
+        EntryType type;
+        std::string data;
+    };
+
+private:
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::string pending;                    // Entries not written yet, shared with the worker.
+    bool quit = false;
+    std::FILE* file = nullptr;
+    std::string path;
+    std::string error;                      // Set by the worker under the mutex, by Start while it is stopped.
+    bool marked = false;
+    void Append(EntryType type, const std::string& data);
+    bool Rebase(const std::string& recoveryPath, const std::string& basePath);
+    static void Rebase(std::vector<Entry>& entries, long long base); // The entries before the save at base as history.
+    void Work();
+    void Stop();                            // Writes the pending entries and closes the file.
+
+public:
+    CoreRecovery() = default;
+    CoreRecovery(const CoreRecovery&) = delete;
+    CoreRecovery& operator=(const CoreRecovery&) = delete;
+    ~CoreRecovery() override;
+    bool Start(const std::string& recoveryPath, const std::string& basePath, const std::string& entries = std::string()); // Removes the previous journal, after Mark moves it.
+    void Mark();                            // When the project file is snapshot.
+    void Unmark() { marked = false; }       // The project file was not written.
+    void Close();                           // Removes the journal, nothing is left to recover.
+    const std::string& GetPath() const { return path; }
+    std::string GetError() const;
+
+    void CommandRecorded(const CoreCommand& command) override;
+    void StepCommitted() override { Append(EntryType::Commit, std::string()); }
+    void StepUndone() override { Append(EntryType::Undo, std::string()); }
+    void StepRedone() override { Append(EntryType::Redo, std::string()); }
+
+    static std::string GetRecoveryPath(const std::string& projectPath) { return projectPath + ".recovery"; }
+    static std::vector<std::string> FindJournals(); // Journals left by sessions that did not close, wherever their projects are.
+
+    // Entries up to the first damaged one, on top of the last project file written, and their frames.
+    // False if the file is not a journal, or if the project file has been written since.
+    static bool Read(const std::string& recoveryPath, std::string& basePath, std::vector<Entry>& entries, std::string& data, std::string& error);
+};
+
+#endif /* CORERECOVERY_HPP */
\ No newline at end of file
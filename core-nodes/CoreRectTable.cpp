@@ -0,0 +1,263 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Rect Table                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreRectTable.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CORE_RECT_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORE_RECT_SSE
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static int LowestBit(unsigned int mask) { unsigned long i; _BitScanForward(&i, mask); return static_cast<int>(i); }
+static int HighestBit(unsigned int mask) { unsigned long i; _BitScanReverse(&i, mask); return static_cast<int>(i); }
+#else
+static int LowestBit(unsigned int mask) { return __builtin_ctz(mask); }
+static int HighestBit(unsigned int mask) { return 31 - __builtin_clz(mask); }
+#endif
+
+void CoreRectTable::Clear()
+{
+    minX.clear();
+    minY.clear();
+    maxX.clear();
+    maxY.clear();
+}
+
+void CoreRectTable::Push(const ImRect& rect)
+{
+    minX.push_back(rect.Min.x);
+    minY.push_back(rect.Min.y);
+    maxX.push_back(rect.Max.x);
+    maxY.push_back(rect.Max.y);
+}
+
+void CoreRectTable::Set(int i, const ImRect& rect)
+{
+    minX[i] = rect.Min.x;
+    minY[i] = rect.Min.y;
+    maxX[i] = rect.Max.x;
+    maxY[i] = rect.Max.y;
+}
+
+bool CoreRectTable::Overlaps(int i, const ImRect& rect) const
+{
+    return rect.Min.y < maxY[i] && rect.Max.y > minY[i] && rect.Min.x < maxX[i] && rect.Max.x > minX[i];
+}
+
+void CoreRectTable::FindOverlapping(const ImRect& rect, std::vector<int>& result) const
+{
+    result.clear();
+    const int n = GetSize();
+    int i = 0;
+#if defined(CORE_RECT_AVX)
+    const __m256 rMinX = _mm256_set1_ps(rect.Min.x);
+    const __m256 rMinY = _mm256_set1_ps(rect.Min.y);
+    const __m256 rMaxX = _mm256_set1_ps(rect.Max.x);
+    const __m256 rMaxY = _mm256_set1_ps(rect.Max.y);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 m = _mm256_cmp_ps(rMinY, _mm256_loadu_ps(&maxY[i]), _CMP_LT_OQ);
+        m = _mm256_and_ps(m, _mm256_cmp_ps(rMaxY, _mm256_loadu_ps(&minY[i]), _CMP_GT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(rMinX, _mm256_loadu_ps(&maxX[i]), _CMP_LT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(rMaxX, _mm256_loadu_ps(&minX[i]), _CMP_GT_OQ));
+        for (auto mask = static_cast<unsigned int>(_mm256_movemask_ps(m)); mask != 0; mask &= mask - 1)
+        {
+            result.push_back(i + LowestBit(mask));
+        }
+    }
+#elif defined(CORE_RECT_SSE)
+    const __m128 rMinX = _mm_set1_ps(rect.Min.x);
+    const __m128 rMinY = _mm_set1_ps(rect.Min.y);
+    const __m128 rMaxX = _mm_set1_ps(rect.Max.x);
+    const __m128 rMaxY = _mm_set1_ps(rect.Max.y);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 m = _mm_cmplt_ps(rMinY, _mm_loadu_ps(&maxY[i]));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(rMaxY, _mm_loadu_ps(&minY[i])));
+        m = _mm_and_ps(m, _mm_cmplt_ps(rMinX, _mm_loadu_ps(&maxX[i])));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(rMaxX, _mm_loadu_ps(&minX[i])));
+        for (auto mask = static_cast<unsigned int>(_mm_movemask_ps(m)); mask != 0; mask &= mask - 1)
+        {
+            result.push_back(i + LowestBit(mask));
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (Overlaps(i, rect) == true)
+        {
+            result.push_back(i);
+        }
+    }
+}
+
+int CoreRectTable::CountOverlapping(const ImRect& rect) const
+{
+    const int n = GetSize();
+    int count = 0;
+    int i = 0;
+#if defined(CORE_RECT_AVX)
+    const __m256 rMinX = _mm256_set1_ps(rect.Min.x);
+    const __m256 rMinY = _mm256_set1_ps(rect.Min.y);
+    const __m256 rMaxX = _mm256_set1_ps(rect.Max.x);
+    const __m256 rMaxY = _mm256_set1_ps(rect.Max.y);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 m = _mm256_cmp_ps(rMinY, _mm256_loadu_ps(&maxY[i]), _CMP_LT_OQ);
+        m = _mm256_and_ps(m, _mm256_cmp_ps(rMaxY, _mm256_loadu_ps(&minY[i]), _CMP_GT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(rMinX, _mm256_loadu_ps(&maxX[i]), _CMP_LT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(rMaxX, _mm256_loadu_ps(&minX[i]), _CMP_GT_OQ));
+        for (auto mask = static_cast<unsigned int>(_mm256_movemask_ps(m)); mask != 0; mask &= mask - 1)
+        {
+            count += 1;
+        }
+    }
+#elif defined(CORE_RECT_SSE)
+    const __m128 rMinX = _mm_set1_ps(rect.Min.x);
+    const __m128 rMinY = _mm_set1_ps(rect.Min.y);
+    const __m128 rMaxX = _mm_set1_ps(rect.Max.x);
+    const __m128 rMaxY = _mm_set1_ps(rect.Max.y);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 m = _mm_cmplt_ps(rMinY, _mm_loadu_ps(&maxY[i]));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(rMaxY, _mm_loadu_ps(&minY[i])));
+        m = _mm_and_ps(m, _mm_cmplt_ps(rMinX, _mm_loadu_ps(&maxX[i])));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(rMaxX, _mm_loadu_ps(&minX[i])));
+        for (auto mask = static_cast<unsigned int>(_mm_movemask_ps(m)); mask != 0; mask &= mask - 1)
+        {
+            count += 1;
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (Overlaps(i, rect) == true)
+        {
+            count += 1;
+        }
+    }
+    return count;
+}
+
+int CoreRectTable::FindLastContaining(ImVec2 point, int end) const
+{
+    // Walks down from the top of the drawing order.
+    int i = end;
+#if defined(CORE_RECT_AVX)
+    const __m256 pX = _mm256_set1_ps(point.x);
+    const __m256 pY = _mm256_set1_ps(point.y);
+    for (; i >= 8; i -= 8)
+    {
+        const int j = i - 8;
+        __m256 m = _mm256_cmp_ps(pX, _mm256_loadu_ps(&minX[j]), _CMP_GE_OQ);
+        m = _mm256_and_ps(m, _mm256_cmp_ps(pY, _mm256_loadu_ps(&minY[j]), _CMP_GE_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(pX, _mm256_loadu_ps(&maxX[j]), _CMP_LT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(pY, _mm256_loadu_ps(&maxY[j]), _CMP_LT_OQ));
+        const auto mask = static_cast<unsigned int>(_mm256_movemask_ps(m));
+        if (mask != 0)
+        {
+            return j + HighestBit(mask);
+        }
+    }
+#elif defined(CORE_RECT_SSE)
+    const __m128 pX = _mm_set1_ps(point.x);
+    const __m128 pY = _mm_set1_ps(point.y);
+    for (; i >= 4; i -= 4)
+    {
+        const int j = i - 4;
+        __m128 m = _mm_cmpge_ps(pX, _mm_loadu_ps(&minX[j]));
+        m = _mm_and_ps(m, _mm_cmpge_ps(pY, _mm_loadu_ps(&minY[j])));
+        m = _mm_and_ps(m, _mm_cmplt_ps(pX, _mm_loadu_ps(&maxX[j])));
+        m = _mm_and_ps(m, _mm_cmplt_ps(pY, _mm_loadu_ps(&maxY[j])));
+        const auto mask = static_cast<unsigned int>(_mm_movemask_ps(m));
+        if (mask != 0)
+        {
+            return j + HighestBit(mask);
+        }
+    }
+#endif
+    for (i = i - 1; i >= 0; i--)
+    {
+        if (point.x >= minX[i] && point.y >= minY[i] && point.x < maxX[i] && point.y < maxY[i])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+ImRect CoreRectTable::GetUnion() const
+{
+    const int n = GetSize();
+    if (n == 0)
+    {
+        return ImRect();
+    }
+    ImRect rect(minX[0], minY[0], maxX[0], maxY[0]);
+    int i = 0;
+#if defined(CORE_RECT_AVX)
+    if (n >= 8)
+    {
+        __m256 loX = _mm256_loadu_ps(&minX[0]);
+        __m256 loY = _mm256_loadu_ps(&minY[0]);
+        __m256 hiX = _mm256_loadu_ps(&maxX[0]);
+        __m256 hiY = _mm256_loadu_ps(&maxY[0]);
+        for (i = 8; i + 8 <= n; i += 8)
+        {
+            loX = _mm256_min_ps(loX, _mm256_loadu_ps(&minX[i]));
+            loY = _mm256_min_ps(loY, _mm256_loadu_ps(&minY[i]));
+            hiX = _mm256_max_ps(hiX, _mm256_loadu_ps(&maxX[i]));
+            hiY = _mm256_max_ps(hiY, _mm256_loadu_ps(&maxY[i]));
+        }
+        alignas(32) float lanes[4][8];
+        _mm256_store_ps(lanes[0], loX);
+        _mm256_store_ps(lanes[1], loY);
+        _mm256_store_ps(lanes[2], hiX);
+        _mm256_store_ps(lanes[3], hiY);
+        for (int k = 0; k < 8; k++)
+        {
+            rect.Add(ImRect(lanes[0][k], lanes[1][k], lanes[2][k], lanes[3][k]));
+        }
+    }
+#elif defined(CORE_RECT_SSE)
+    if (n >= 4)
+    {
+        __m128 loX = _mm_loadu_ps(&minX[0]);
+        __m128 loY = _mm_loadu_ps(&minY[0]);
+        __m128 hiX = _mm_loadu_ps(&maxX[0]);
+        __m128 hiY = _mm_loadu_ps(&maxY[0]);
+        for (i = 4; i + 4 <= n; i += 4)
+        {
+            loX = _mm_min_ps(loX, _mm_loadu_ps(&minX[i]));
+            loY = _mm_min_ps(loY, _mm_loadu_ps(&minY[i]));
+            hiX = _mm_max_ps(hiX, _mm_loadu_ps(&maxX[i]));
+            hiY = _mm_max_ps(hiY, _mm_loadu_ps(&maxY[i]));
+        }
+        alignas(16) float lanes[4][4];
+        _mm_store_ps(lanes[0], loX);
+        _mm_store_ps(lanes[1], loY);
+        _mm_store_ps(lanes[2], hiX);
+        _mm_store_ps(lanes[3], hiY);
+        for (int k = 0; k < 4; k++)
+        {
+            rect.Add(ImRect(lanes[0][k], lanes[1][k], lanes[2][k], lanes[3][k]));
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        rect.Add(ImRect(minX[i], minY[i], maxX[i], maxY[i]));
+    }
+    return rect;
+}
\ No newline at end of file
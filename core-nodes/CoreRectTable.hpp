@@ -0,0 +1,42 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Rect Table                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORERECTTABLE_HPP
+#define CORERECTTABLE_HPP
+
+#include "CoreSerialize.hpp"
+#include <vector>
+
+// Rectangles as parallel coordinate arrays, in the order of the node vector. The queries stream
+// the arrays with AVX or SSE2 compares when the compiler targets them, and fall back to scalar code.
+class CoreRectTable
+{
+private:
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+
+public:
+    CoreRectTable() = default;
+    virtual ~CoreRectTable() = default;
+    void Clear();
+    void Push(const ImRect& rect);
+    void Set(int i, const ImRect& rect);
+    int GetSize() const { return static_cast<int>(minX.size()); }
+    bool Overlaps(int i, const ImRect& rect) const;
+
+    // Same tests as ImRect::Overlaps and ImRect::Contains.
+    void FindOverlapping(const ImRect& rect, std::vector<int>& result) const; // Ascending.
+    int CountOverlapping(const ImRect& rect) const;
+    int FindLastContaining(ImVec2 point, int end) const; // Highest index below end, or -1.
+    ImRect GetUnion() const;
+};
+
+#endif /* CORERECTTABLE_HPP */
\ No newline at end of file
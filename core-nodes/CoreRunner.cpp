@@ -0,0 +1,92 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Runner                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreRunner.hpp"
+#include <chrono>
+
+CoreRunner::~CoreRunner()
+{
+    Stop();
+}
+
+bool CoreRunner::Start(const CoreProgram& program, const SimSettings& simSettings)
+{
+    Stop();
+    if (simulation.Init(program, simSettings) == false)
+    {
+        return false;
+    }
+    settings = simSettings;
+    elapsed = 0.0;
+    stopRequest.store(false, std::memory_order_relaxed);
+    running.store(true, std::memory_order_release);
+    worker = std::thread(&CoreRunner::Work, this);
+    return true;
+}
+
+void CoreRunner::Stop()
+{
+    stopRequest.store(true, std::memory_order_relaxed);
+    if (worker.joinable() == true)
+    {
+        worker.join();
+    }
+}
+
+bool CoreRunner::IsFinished()
+{
+    if (worker.joinable() == false || IsRunning() == true)
+    {
+        return false;
+    }
+    worker.join();
+    return true;
+}
+
+const SimSnapshot& CoreRunner::GetSnapshot()
+{
+    snapshots.Update();
+    return snapshots.Front();
+}
+
+void CoreRunner::Work()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto lastPublish = start;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(publishPeriod));
+    auto publish = [this]()
+    {
+        SimSnapshot& snapshot = snapshots.Back();
+        snapshot.time = simulation.GetTime();
+        snapshot.iStep = simulation.GetStepIndex();
+        snapshot.signals = simulation.GetProgram().GetSignals(); // Reuses the slot capacity.
+        snapshot.pacer = pacer.GetStats();
+        snapshots.Publish();
+    };
+    const double timeScale = simulation.GetSettings().GetTimeScale();
+    pacer.Start(timeScale > 0.0 ? timeScale : 1.0);
+    publish();
+    while (stopRequest.load(std::memory_order_relaxed) == false && simulation.Step() == true)
+    {
+        if (timeScale > 0.0 && pacer.WaitUntil(simulation.GetTime(), stopRequest) == false)
+        {
+            break;
+        }
+        const auto now = Clock::now();
+        if (now - lastPublish >= period)
+        {
+            publish();
+            lastPublish = now;
+        }
+    }
+    publish();
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    running.store(false, std::memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Runner                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORERUNNER_HPP
+#define CORERUNNER_HPP
+
+#include "CoreSimulation.hpp"
+#include "CorePacer.hpp"
+#include <atomic>
+#include <thread>
+#include <array>
+
+// Single producer, single consumer buffer. The writer and the reader own one slot each,
+// the third slot is exchanged atomically, so neither side ever waits for the other.
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr int freshBit = 4;
+    std::array<T, 3> slots;
+    std::atomic<int> middle{ 1 };
+    int back = 0;
+    int front = 2;
+
+public:
+    T& Back() { return slots[back]; }
+    void Publish() { back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & ~freshBit; }
+    bool Update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0)
+        {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & ~freshBit;
+        return true;
+    }
+    const T& Front() const { return slots[front]; }
+};
+
+// Signals at a sample, as seen by the UI.
+struct SimSnapshot
+{
+    double time = 0.0;
+    long long iStep = 0;
+    std::vector<double> signals;
+    PacerStats pacer;
+};
+
+// Runs a simulation on a worker thread, so that the frame loop never throttles the integration.
+// Start, Stop and the getters are called from the UI thread.
+class CoreRunner
+{
+private:
+    CoreSimulation simulation;
+    SimSettings settings;               // Copy for the UI, the worker owns the simulation.
+    CorePacer pacer;
+    std::thread worker;
+    std::atomic<bool> running{ false };
+    std::atomic<bool> stopRequest{ false };
+    TripleBuffer<SimSnapshot> snapshots;
+    double publishPeriod = 1.0 / 120.0; // Wall time between snapshots [s].
+    double elapsed = 0.0;
+    void Work();
+
+public:
+    CoreRunner() = default;
+    CoreRunner(const CoreRunner&) = delete;
+    CoreRunner& operator=(const CoreRunner&) = delete;
+    virtual ~CoreRunner();
+    bool Start(const CoreProgram& program, const SimSettings& simSettings);
+    void Stop();
+    void RequestStop() { stopRequest.store(true, std::memory_order_relaxed); }
+    bool IsRunning() const { return running.load(std::memory_order_acquire); }
+    bool IsFinished();
+    const SimSettings& GetSettings() const { return settings; } // Of the last run.
+
+    // Latest published samples. Valid until the next call of GetSnapshot.
+    const SimSnapshot& GetSnapshot();
+
+    // Valid after IsFinished returns true.
+    const CoreSimulation& GetSimulation() const { return simulation; }
+    double GetElapsed() const { return elapsed; }
+    bool IsStopped() const { return stopRequest.load(std::memory_order_relaxed); }
+};
+
+#endif /* CORERUNNER_HPP */
\ No newline at end of file
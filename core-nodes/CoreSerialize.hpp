@@ -0,0 +1,44 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Serialize                                                                       *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORESERIALIZE_HPP
+#define CORESERIALIZE_HPP
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <string>
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "pugixml.hpp"
+#include "Notifier.hpp"
+
+// Xml helpers of the project file. Only the value types of ImGui are used, not its context.
+void SaveImRect(pugi::xml_node& xmlNode, const std::string& name, const ImRect& rect);
+void SaveImVec2(pugi::xml_node& xmlNode, const std::string& name, const ImVec2& vec);
+void SaveImColor(pugi::xml_node& xmlNode, const std::string& name, const ImColor& color);
+void SaveFloat(pugi::xml_node& xmlNode, const std::string& name, float data);
+void SaveDouble(pugi::xml_node& xmlNode, const std::string& name, double data);
+void SaveString(pugi::xml_node& xmlNode, const std::string& name, const std::string& str);
+void SaveInt(pugi::xml_node& xmlNode, const std::string& name, int i);
+void SaveBool(pugi::xml_node& xmlNode, const std::string& name, bool b);
+
+ImRect LoadImRect(const pugi::xml_node& xmlNode, const std::string& name);
+ImVec2 LoadImVec2(const pugi::xml_node& xmlNode, const std::string& name);
+ImColor LoadImColor(const pugi::xml_node& xmlNode, const std::string& name);
+float LoadFloat(const pugi::xml_node& xmlNode, const std::string& name);
+double LoadDouble(const pugi::xml_node& xmlNode, const std::string& name);
+std::string LoadString(const pugi::xml_node& xmlNode, const std::string& name);
+int LoadInt(const pugi::xml_node& xmlNode, const std::string& name);
+bool LoadBool(const pugi::xml_node& xmlNode, const std::string& name);
+
+// Version of the project files. v0.1.0 files also store the node geometry, later files store only
+// the authored state as attributes and the geometry is built again on load.
+const std::string projectVersion{ "v0.2.0" };
+bool IsProjectV1(const pugi::xml_node& root);
+
+#endif /* CORESERIALIZE_HPP */
\ No newline at end of file
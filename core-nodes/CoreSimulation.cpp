@@ -0,0 +1,151 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Simulation                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreSimulation.hpp"
+#include <cmath>
+
+void SimSettings::Load(const pugi::xml_node& xmlNode)
+{
+    auto sim = xmlNode.child("simulation");
+    solver = static_cast<SolverType>(sim.attribute("solver").as_int(static_cast<int>(SolverType::RK4)));
+    sampleTime = sim.attribute("sampleTime").as_double(0.01);
+    stopTime = sim.attribute("stopTime").as_double(5.0);
+    relTol = sim.attribute("relTol").as_double(1e-6);
+    absTol = sim.attribute("absTol").as_double(1e-8);
+    speed = sim.attribute("speed").as_string("realTime");
+    timeScale = sim.attribute("timeScale").as_double(1.0);
+}
+
+void SimSettings::Save(CoreBinaryWriter& writer) const
+{
+    auto& header = writer.GetHeader();
+    header.solver = static_cast<int>(solver);
+    header.sampleTime = sampleTime;
+    header.stopTime = stopTime;
+    header.relTol = relTol;
+    header.absTol = absTol;
+    header.speed = writer.AddString(speed);
+    header.timeScale = timeScale;
+}
+
+void SimSettings::Load(const CoreBinaryReader& reader)
+{
+    const auto& header = reader.GetHeader();
+    solver = static_cast<SolverType>(header.solver);
+    sampleTime = header.sampleTime;
+    stopTime = header.stopTime;
+    relTol = header.relTol;
+    absTol = header.absTol;
+    speed = reader.GetString(header.speed);
+    timeScale = header.timeScale;
+}
+
+double SimSettings::GetTimeScale() const
+{
+    if (speed == "realTime")
+    {
+        return 1.0;
+    }
+    if (speed == "scaled")
+    {
+        return timeScale;
+    }
+    return 0.0;
+}
+
+bool CoreSimulation::Init(const CoreProgram& compiledProgram, const SimSettings& simSettings)
+{
+    settings = simSettings;
+    program = compiledProgram;
+    solver.reset();
+    return Restart();
+}
+
+bool CoreSimulation::Restart()
+{
+    if (solver == nullptr)
+    {
+        solver = CoreSolver::Create(settings.solver);
+    }
+    iStep = 0;
+    stepNum = 0;
+    time = 0.0;
+    error.clear();
+    if (solver == nullptr)
+    {
+        error = "Unknown solver.";
+        return false;
+    }
+    if (settings.sampleTime <= 0.0 || settings.stopTime < 0.0)
+    {
+        error = "Sample time must be positive and stop time must not be negative.";
+        return false;
+    }
+    if (settings.relTol <= 0.0 || settings.absTol <= 0.0)
+    {
+        error = "Tolerances must be positive.";
+        return false;
+    }
+    if (std::find(speedNames.begin(), speedNames.end(), settings.speed) == speedNames.end() || (settings.speed == "scaled" && settings.timeScale <= 0.0))
+    {
+        error = "Unknown speed or non-positive time scale.";
+        return false;
+    }
+    stepNum = std::llround(settings.stopTime / settings.sampleTime);
+    solver->SetTolerance(settings.relTol, settings.absTol);
+    solver->Initialize(program, 0.0);
+    xs.assign(program.GetStateNum(), 0.0);
+    return true;
+}
+
+bool CoreSimulation::Step()
+{
+    if (IsFinished() == true)
+    {
+        return false;
+    }
+    if (solver->IsAdaptive() == true)
+    {
+        // The solver steps freely and the samples are interpolated from its dense output.
+        const double ts = (iStep + 1 == stepNum) ? settings.stopTime : (iStep + 1) * settings.sampleTime;
+        while (solver->GetTime() < ts)
+        {
+            if (solver->Advance(program, settings.stopTime) == false)
+            {
+                error = "Step size too small at t = " + std::to_string(solver->GetTime()) + ".";
+                stepNum = iStep;
+                return false;
+            }
+        }
+        solver->Interpolate(ts, xs.data());
+        program.Outputs(ts, xs.data());
+        time = ts;
+    }
+    else
+    {
+        solver->Step(program, settings.sampleTime);
+        if (solver->GetError().empty() == false)
+        {
+            error = solver->GetError();
+            stepNum = iStep;
+            return false;
+        }
+        solver->Outputs(program);
+        time = solver->GetTime();
+    }
+    iStep += 1;
+    return true;
+}
+
+void CoreSimulation::Run()
+{
+    while (Step() == true)
+    {
+    }
+}
\ No newline at end of file
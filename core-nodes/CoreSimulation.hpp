@@ -0,0 +1,71 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Simulation                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORESIMULATION_HPP
+#define CORESIMULATION_HPP
+
+#include "CoreSolver.hpp"
+#include "CoreBinary.hpp"
+
+const std::vector<std::string> speedNames
+{
+    "realTime",
+    "scaled",
+    "asFast"
+    // Stored by name in project files.
+};
+
+// Settings of the <simulation> element.
+struct SimSettings
+{
+    SolverType solver = SolverType::RK4;
+    double sampleTime = 0.01;
+    double stopTime = 5.0;
+    double relTol = 1e-6;               // Tolerances of the variable-step solvers.
+    double absTol = 1e-8;
+    std::string speed{ "realTime" };
+    double timeScale = 1.0;             // Simulation seconds per wall second, used when speed is "scaled".
+    double GetTimeScale() const;        // Zero when not paced.
+    void Load(const pugi::xml_node& xmlNode);
+    void Save(CoreBinaryWriter& writer) const;
+    void Load(const CoreBinaryReader& reader);
+};
+
+class CoreSimulation
+{
+private:
+    SimSettings settings;
+    CoreProgram program;
+    std::unique_ptr<CoreSolver> solver;
+    long long stepNum = 0;
+    long long iStep = 0;
+    double time = 0.0;                  // Time of the last sample.
+    std::vector<double> xs;             // Interpolated states at the sample time.
+    std::string error;
+
+public:
+    CoreSimulation() = default;
+    virtual ~CoreSimulation() = default;
+    bool Init(const CoreProgram& compiledProgram, const SimSettings& simSettings);
+    bool Restart();                     // Runs again from t = 0, keeping the program and its parameters.
+    void SetParam(int i, double value) { program.SetParam(i, value); }
+    bool Step();
+    void Run();
+    bool IsFinished() const { return iStep >= stepNum; }
+
+    std::string GetError() const { return error; }
+    double GetTime() const { return time; }
+    const SolverStats* GetSolverStats() const { return solver ? &solver->GetStats() : nullptr; }
+    long long GetStepNum() const { return stepNum; }
+    long long GetStepIndex() const { return iStep; }
+    const SimSettings& GetSettings() const { return settings; }
+    const CoreProgram& GetProgram() const { return program; }
+};
+
+#endif /* CORESIMULATION_HPP */
\ No newline at end of file
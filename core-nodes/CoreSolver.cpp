@@ -0,0 +1,518 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Solver                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreSolver.hpp"
+#include <cmath>
+#include <limits>
+
+std::unique_ptr<CoreSolver> CoreSolver::Create(SolverType type)
+{
+    switch (type)
+    {
+        case SolverType::Euler: return std::make_unique<EulerSolver>();
+        case SolverType::Heun: return std::make_unique<HeunSolver>();
+        case SolverType::RK4: return std::make_unique<RK4Solver>();
+        case SolverType::DoPri5: return std::make_unique<DoPri5Solver>();
+        case SolverType::BDF: return std::make_unique<BDFSolver>();
+        default: return nullptr;
+    }
+}
+
+void CoreSolver::Axpy(std::vector<double>& out, const std::vector<double>& x, double a, const std::vector<double>& k)
+{
+    const size_t n = x.size();
+    double* o = out.data();
+    const double* px = x.data();
+    const double* pk = k.data();
+    for (size_t i = 0; i < n; i++)
+    {
+        o[i] = px[i] + a * pk[i];
+    }
+}
+
+void CoreSolver::Initialize(CoreProgram& program, double t0)
+{
+    t = t0;
+    stats = SolverStats();
+    error.clear();
+    x.assign(program.GetStateNum(), 0.0);
+    program.Initialize(t, x.data());
+}
+
+void EulerSolver::Initialize(CoreProgram& program, double t0)
+{
+    CoreSolver::Initialize(program, t0);
+    k1.assign(x.size(), 0.0);
+}
+
+void EulerSolver::Step(CoreProgram& program, double h)
+{
+    program.Derivatives(t, x.data(), k1.data());
+    Axpy(x, x, h, k1);
+    t += h;
+}
+
+void HeunSolver::Initialize(CoreProgram& program, double t0)
+{
+    CoreSolver::Initialize(program, t0);
+    k1.assign(x.size(), 0.0);
+    k2.assign(x.size(), 0.0);
+    xt.assign(x.size(), 0.0);
+}
+
+void HeunSolver::Step(CoreProgram& program, double h)
+{
+    program.Derivatives(t, x.data(), k1.data());
+    Axpy(xt, x, h, k1);
+    program.Derivatives(t + h, xt.data(), k2.data());
+    const size_t n = x.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        x[i] += 0.5 * h * (k1[i] + k2[i]);
+    }
+    t += h;
+}
+
+void RK4Solver::Initialize(CoreProgram& program, double t0)
+{
+    CoreSolver::Initialize(program, t0);
+    k1.assign(x.size(), 0.0);
+    k2.assign(x.size(), 0.0);
+    k3.assign(x.size(), 0.0);
+    k4.assign(x.size(), 0.0);
+    xt.assign(x.size(), 0.0);
+}
+
+void RK4Solver::Step(CoreProgram& program, double h)
+{
+    program.Derivatives(t, x.data(), k1.data());
+    Axpy(xt, x, 0.5 * h, k1);
+    program.Derivatives(t + 0.5 * h, xt.data(), k2.data());
+    Axpy(xt, x, 0.5 * h, k2);
+    program.Derivatives(t + 0.5 * h, xt.data(), k3.data());
+    Axpy(xt, x, h, k3);
+    program.Derivatives(t + h, xt.data(), k4.data());
+    const size_t n = x.size();
+    const double h6 = h / 6.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        x[i] += h6 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+    }
+    t += h;
+}
+
+// Dormand-Prince 5(4) tableau.
+static constexpr double c2 = 1.0 / 5.0;
+static constexpr double c3 = 3.0 / 10.0;
+static constexpr double c4 = 4.0 / 5.0;
+static constexpr double c5 = 8.0 / 9.0;
+static constexpr double a21 = 1.0 / 5.0;
+static constexpr double a31 = 3.0 / 40.0;
+static constexpr double a32 = 9.0 / 40.0;
+static constexpr double a41 = 44.0 / 45.0;
+static constexpr double a42 = -56.0 / 15.0;
+static constexpr double a43 = 32.0 / 9.0;
+static constexpr double a51 = 19372.0 / 6561.0;
+static constexpr double a52 = -25360.0 / 2187.0;
+static constexpr double a53 = 64448.0 / 6561.0;
+static constexpr double a54 = -212.0 / 729.0;
+static constexpr double a61 = 9017.0 / 3168.0;
+static constexpr double a62 = -355.0 / 33.0;
+static constexpr double a63 = 46732.0 / 5247.0;
+static constexpr double a64 = 49.0 / 176.0;
+static constexpr double a65 = -5103.0 / 18656.0;
+static constexpr double a71 = 35.0 / 384.0;
+static constexpr double a73 = 500.0 / 1113.0;
+static constexpr double a74 = 125.0 / 192.0;
+static constexpr double a75 = -2187.0 / 6784.0;
+static constexpr double a76 = 11.0 / 84.0;
+static constexpr double e1 = 71.0 / 57600.0;
+static constexpr double e3 = -71.0 / 16695.0;
+static constexpr double e4 = 71.0 / 1920.0;
+static constexpr double e5 = -17253.0 / 339200.0;
+static constexpr double e6 = 22.0 / 525.0;
+static constexpr double e7 = -1.0 / 40.0;
+static constexpr double d1 = -12715105075.0 / 11282082432.0;
+static constexpr double d3 = 87487479700.0 / 32700410799.0;
+static constexpr double d4 = -10690763975.0 / 1880347072.0;
+static constexpr double d5 = 701980252875.0 / 199316789632.0;
+static constexpr double d6 = -1453857185.0 / 822651844.0;
+static constexpr double d7 = 69997945.0 / 29380423.0;
+
+// Step size controller.
+static constexpr double safety = 0.9;
+static constexpr double facMin = 0.2;
+static constexpr double facMax = 10.0;
+static constexpr double beta = 0.04;
+static constexpr double expo = 0.2 - beta * 0.75;
+
+void DoPri5Solver::Initialize(CoreProgram& program, double t0)
+{
+    CoreSolver::Initialize(program, t0);
+    const size_t n = x.size();
+    for (auto v : { &k1, &k2, &k3, &k4, &k5, &k6, &k7, &xt, &xNew, &r1, &r2, &r3, &r4, &r5 })
+    {
+        v->assign(n, 0.0);
+    }
+    h = 0.0;
+    errOld = 1e-4;
+    tOld = t;
+    hOld = 0.0;
+    fsal = false;
+    r1 = x;
+}
+
+double DoPri5Solver::InitialStep(CoreProgram& program, double tMax)
+{
+    // Hairer, Norsett, Wanner: Solving ODEs I, II.4.
+    const size_t n = x.size();
+    double dx0 = 0.0;
+    double df0 = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double sk = absTol + relTol * std::abs(x[i]);
+        dx0 += (x[i] / sk) * (x[i] / sk);
+        df0 += (k1[i] / sk) * (k1[i] / sk);
+    }
+    dx0 = std::sqrt(dx0 / n);
+    df0 = std::sqrt(df0 / n);
+    double h0 = (dx0 < 1e-5 || df0 < 1e-5) ? 1e-6 : 0.01 * dx0 / df0;
+    h0 = std::min(h0, tMax - t);
+    Axpy(xt, x, h0, k1);
+    program.Derivatives(t + h0, xt.data(), k2.data());
+    double ddf = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double sk = absTol + relTol * std::abs(x[i]);
+        ddf += ((k2[i] - k1[i]) / sk) * ((k2[i] - k1[i]) / sk);
+    }
+    ddf = std::sqrt(ddf / n) / h0;
+    const double dMax = std::max(df0, ddf);
+    const double h1 = (dMax <= 1e-15) ? std::max(1e-6, h0 * 1e-3) : std::pow(0.01 / dMax, 0.2);
+    return std::min(100.0 * h0, h1);
+}
+
+bool DoPri5Solver::Advance(CoreProgram& program, double tMax)
+{
+    const size_t n = x.size();
+    if (t >= tMax)
+    {
+        return true;
+    }
+    if (n == 0)
+    {
+        // Nothing to integrate, a single step reaches the end.
+        tOld = t;
+        hOld = tMax - t;
+        t = tMax;
+        stats.accepted += 1;
+        return true;
+    }
+    if (fsal == false)
+    {
+        program.Derivatives(t, x.data(), k1.data());
+        fsal = true;
+    }
+    if (h <= 0.0)
+    {
+        h = InitialStep(program, tMax);
+    }
+
+    while (true)
+    {
+        bool last = false;
+        if (t + h >= tMax)
+        {
+            h = tMax - t;
+            last = true;
+        }
+        if (h < 16.0 * std::numeric_limits<double>::epsilon() * std::abs(t))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < n; i++) { xt[i] = x[i] + h * a21 * k1[i]; }
+        program.Derivatives(t + c2 * h, xt.data(), k2.data());
+        for (size_t i = 0; i < n; i++) { xt[i] = x[i] + h * (a31 * k1[i] + a32 * k2[i]); }
+        program.Derivatives(t + c3 * h, xt.data(), k3.data());
+        for (size_t i = 0; i < n; i++) { xt[i] = x[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]); }
+        program.Derivatives(t + c4 * h, xt.data(), k4.data());
+        for (size_t i = 0; i < n; i++) { xt[i] = x[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]); }
+        program.Derivatives(t + c5 * h, xt.data(), k5.data());
+        for (size_t i = 0; i < n; i++) { xt[i] = x[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]); }
+        const double tNew = last ? tMax : t + h;
+        program.Derivatives(tNew, xt.data(), k6.data());
+        for (size_t i = 0; i < n; i++) { xNew[i] = x[i] + h * (a71 * k1[i] + a73 * k3[i] + a74 * k4[i] + a75 * k5[i] + a76 * k6[i]); }
+        program.Derivatives(tNew, xNew.data(), k7.data());
+
+        double err = 0.0;
+        for (size_t i = 0; i < n; i++)
+        {
+            const double sk = absTol + relTol * std::max(std::abs(x[i]), std::abs(xNew[i]));
+            const double ei = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]) / sk;
+            err += ei * ei;
+        }
+        err = std::sqrt(err / n);
+
+        if (err <= 1.0)
+        {
+            // Accepted. Keep the dense output of the step before moving on.
+            for (size_t i = 0; i < n; i++)
+            {
+                const double dxi = xNew[i] - x[i];
+                const double bspl = h * k1[i] - dxi;
+                r1[i] = x[i];
+                r2[i] = dxi;
+                r3[i] = bspl;
+                r4[i] = dxi - h * k7[i] - bspl;
+                r5[i] = h * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] + d5 * k5[i] + d6 * k6[i] + d7 * k7[i]);
+            }
+            tOld = t;
+            hOld = h;
+            x.swap(xNew);
+            k1.swap(k7);
+            t = tNew;
+
+            stats.accepted += 1;
+            stats.hLast = h;
+            stats.hMin = (stats.accepted == 1) ? h : std::min(stats.hMin, h);
+            stats.hMax = std::max(stats.hMax, h);
+
+            // PI controller, uses the error of the previous step as well.
+            const double e = std::max(err, 1e-10);
+            const double fac = std::clamp(std::pow(e, expo) / std::pow(errOld, beta) / safety, 1.0 / facMax, 1.0 / facMin);
+            errOld = e;
+            h = h / fac;
+            return true;
+        }
+        stats.rejected += 1;
+        h = h / std::min(1.0 / facMin, std::pow(err, expo) / safety);
+    }
+}
+
+void DoPri5Solver::Step(CoreProgram& program, double hStep)
+{
+    const double tEnd = t + hStep;
+    while (t < tEnd && Advance(program, tEnd) == true)
+    {
+    }
+}
+
+void DoPri5Solver::Interpolate(double tq, double* xq) const
+{
+    if (hOld <= 0.0)
+    {
+        std::copy(x.begin(), x.end(), xq);
+        return;
+    }
+    const double theta = (tq - tOld) / hOld;
+    const double theta1 = 1.0 - theta;
+    const size_t n = x.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        xq[i] = r1[i] + theta * (r2[i] + theta1 * (r3[i] + theta * (r4[i] + theta1 * r5[i])));
+    }
+}
+
+void BDFSolver::Initialize(CoreProgram& program, double t0)
+{
+    CoreSolver::Initialize(program, t0);
+    const size_t n = x.size();
+    for (auto v : { &xPrev, &f0, &ft, &xt, &xNew, &psi, &delta })
+    {
+        v->assign(n, 0.0);
+    }
+    hPrev = 0.0;
+
+    program.JacobianPattern(pattern);
+    jac.assign(pattern.GetNonzeroNum(), 0.0);
+    lu.Analyze(pattern);
+    luValid = false;
+    jacStale = true;
+    jacFresh = false;
+
+    std::vector<int> color;
+    colorCols.assign(ColorColumns(pattern, color), std::vector<int>());
+    for (int j = 0; j < pattern.n; j++)
+    {
+        colorCols[color[j]].push_back(j);
+    }
+    colPtr.assign(pattern.n + 1, 0);
+    for (const auto& j : pattern.col)
+    {
+        colPtr[j + 1] += 1;
+    }
+    for (int j = 0; j < pattern.n; j++)
+    {
+        colPtr[j + 1] += colPtr[j];
+    }
+    colEntry.assign(pattern.col.size(), 0);
+    colRow.assign(pattern.col.size(), 0);
+    std::vector<int> next(colPtr.begin(), colPtr.end() - 1);
+    for (int i = 0; i < pattern.n; i++)
+    {
+        for (int p = pattern.rowPtr[i]; p < pattern.rowPtr[i + 1]; p++)
+        {
+            const int q = next[pattern.col[p]]++;
+            colEntry[q] = p;
+            colRow[q] = i;
+        }
+    }
+}
+
+void BDFSolver::UpdateJacobian(CoreProgram& program)
+{
+    // One evaluation per color. Each row has at most one perturbed column of the color.
+    const double sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+    program.Derivatives(t, x.data(), f0.data());
+    xt = x;
+    for (const auto& cols : colorCols)
+    {
+        for (const auto& j : cols)
+        {
+            xt[j] = x[j] + sqrtEps * std::max(std::abs(x[j]), 1.0);
+        }
+        program.Derivatives(t, xt.data(), ft.data());
+        for (const auto& j : cols)
+        {
+            const double dj = xt[j] - x[j];
+            for (int q = colPtr[j]; q < colPtr[j + 1]; q++)
+            {
+                jac[colEntry[q]] = (ft[colRow[q]] - f0[colRow[q]]) / dj;
+            }
+            xt[j] = x[j];
+        }
+    }
+    jacStale = false;
+    jacFresh = true;
+    luValid = false;
+    stats.jacobians += 1;
+}
+
+bool BDFSolver::Newton(CoreProgram& program, double tNew, double hGamma)
+{
+    // Simplified Newton on xNew - hGamma * f(tNew, xNew) - psi = 0.
+    if (luValid == false || luAlpha != -hGamma)
+    {
+        luAlpha = -hGamma;
+        luValid = lu.Factor(jac.data(), luAlpha, 1.0);
+        if (luValid == false)
+        {
+            return false;
+        }
+    }
+    const size_t n = x.size();
+    double normOld = 0.0;
+    for (int it = 0; it < 7; it++)
+    {
+        program.Derivatives(tNew, xNew.data(), ft.data());
+        for (size_t i = 0; i < n; i++)
+        {
+            delta[i] = xNew[i] - hGamma * ft[i] - psi[i];
+        }
+        lu.Solve(delta.data());
+        double norm = 0.0;
+        for (size_t i = 0; i < n; i++)
+        {
+            xNew[i] -= delta[i];
+            const double di = delta[i] / (absTol + relTol * std::abs(xNew[i]));
+            norm += di * di;
+        }
+        norm = std::sqrt(norm / n);
+        if (it > 0 && norm > 0.9 * normOld)
+        {
+            return false;
+        }
+        if (norm <= 0.03)
+        {
+            if (it > 3)
+            {
+                jacStale = true; // Slow convergence, refresh at the next step.
+            }
+            return true;
+        }
+        normOld = norm;
+    }
+    return false;
+}
+
+bool BDFSolver::Attempt(CoreProgram& program, double h, int depth)
+{
+    const size_t n = x.size();
+    for (int retry = 0; retry < 2; retry++)
+    {
+        if (jacStale == true)
+        {
+            UpdateJacobian(program);
+        }
+        const bool bdf2 = hPrev == h;
+        double hGamma = h;
+        for (size_t i = 0; i < n; i++)
+        {
+            if (bdf2 == true)
+            {
+                psi[i] = (4.0 * x[i] - xPrev[i]) / 3.0;
+                xNew[i] = 2.0 * x[i] - xPrev[i];
+            }
+            else
+            {
+                psi[i] = x[i];
+                xNew[i] = x[i];
+            }
+        }
+        if (bdf2 == true)
+        {
+            hGamma = 2.0 * h / 3.0;
+        }
+        if (Newton(program, t + h, hGamma) == true)
+        {
+            xPrev.swap(x);
+            x.swap(xNew);
+            t += h;
+            hPrev = h;
+            jacFresh = false;
+            stats.accepted += 1;
+            stats.hLast = h;
+            stats.hMin = (stats.accepted == 1) ? h : std::min(stats.hMin, h);
+            stats.hMax = std::max(stats.hMax, h);
+            return true;
+        }
+        stats.rejected += 1;
+        if (jacFresh == true)
+        {
+            break;
+        }
+        jacStale = true;
+    }
+
+    // Newton failed with a fresh Jacobian. Halve the step and restart from implicit Euler.
+    if (depth >= 20)
+    {
+        return false;
+    }
+    hPrev = 0.0;
+    return Attempt(program, 0.5 * h, depth + 1) && Attempt(program, 0.5 * h, depth + 1);
+}
+
+void BDFSolver::Step(CoreProgram& program, double h)
+{
+    if (error.empty() == false)
+    {
+        return;
+    }
+    if (x.empty() == true)
+    {
+        t += h;
+        return;
+    }
+    if (Attempt(program, h, 0) == false)
+    {
+        error = "Newton iteration failed at t = " + std::to_string(t) + ".";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Solver                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORESOLVER_HPP
+#define CORESOLVER_HPP
+
+#include "CoreProgram.hpp"
+#include <memory>
+#include <algorithm>
+
+const std::vector<std::string> solverTypeNames
+{
+    "None",
+    "Euler",
+    "Heun",
+    "RK4",
+    "DoPri5",
+    "BDF"
+};
+
+enum class SolverType
+{
+    None = 0,
+    Euler,
+    Heun,
+    RK4,
+    DoPri5,
+    BDF
+    // Warning! Values are stored in project files. If you update this, update solver type names vector.
+};
+
+struct SolverStats
+{
+    long long accepted = 0;
+    long long rejected = 0;
+    double hMin = 0.0;
+    double hMax = 0.0;
+    double hLast = 0.0;
+    long long jacobians = 0;
+};
+
+// Integrates the continuous states of a compiled program. States are kept in one contiguous vector.
+class CoreSolver
+{
+protected:
+    double t = 0.0;
+    std::vector<double> x;              // State vector.
+    SolverStats stats;
+    std::string error;
+    static void Axpy(std::vector<double>& out, const std::vector<double>& x, double a, const std::vector<double>& k);
+
+public:
+    CoreSolver() = default;
+    virtual ~CoreSolver() = default;
+    static std::unique_ptr<CoreSolver> Create(SolverType type);
+    virtual void Initialize(CoreProgram& program, double t0);
+    virtual void Step(CoreProgram& program, double h) = 0;
+    void Outputs(CoreProgram& program) { program.Outputs(t, x.data()); }
+    double GetTime() const { return t; }
+    const std::vector<double>& GetStates() const { return x; }
+    const SolverStats& GetStats() const { return stats; }
+    const std::string& GetError() const { return error; }
+
+    // Variable-step solvers choose their own steps and interpolate in between.
+    virtual bool IsAdaptive() const { return false; }
+    virtual void SetTolerance([[maybe_unused]] double relTol, [[maybe_unused]] double absTol) {}
+    virtual bool Advance(CoreProgram& program, double tMax) { Step(program, tMax - t); return true; }
+    virtual void Interpolate([[maybe_unused]] double tq, double* xq) const { std::copy(x.begin(), x.end(), xq); }
+};
+
+class EulerSolver : public CoreSolver
+{
+private:
+    std::vector<double> k1;
+public:
+    void Initialize(CoreProgram& program, double t0) override;
+    void Step(CoreProgram& program, double h) override;
+};
+
+class HeunSolver : public CoreSolver
+{
+private:
+    std::vector<double> k1;
+    std::vector<double> k2;
+    std::vector<double> xt;
+public:
+    void Initialize(CoreProgram& program, double t0) override;
+    void Step(CoreProgram& program, double h) override;
+};
+
+class RK4Solver : public CoreSolver
+{
+private:
+    std::vector<double> k1;
+    std::vector<double> k2;
+    std::vector<double> k3;
+    std::vector<double> k4;
+    std::vector<double> xt;
+public:
+    void Initialize(CoreProgram& program, double t0) override;
+    void Step(CoreProgram& program, double h) override;
+};
+
+// Dormand-Prince 5(4) with error control and dense output.
+class DoPri5Solver : public CoreSolver
+{
+private:
+    double relTol = 1e-6;
+    double absTol = 1e-8;
+    double h = 0.0;                     // Next step size.
+    double errOld = 1e-4;               // Error of the last accepted step, for the PI step size controller.
+    double tOld = 0.0;                  // Start of the last accepted step.
+    double hOld = 0.0;                  // Size of the last accepted step.
+    bool fsal = false;                  // k1 holds the derivative at (t, x).
+    std::vector<double> k1;
+    std::vector<double> k2;
+    std::vector<double> k3;
+    std::vector<double> k4;
+    std::vector<double> k5;
+    std::vector<double> k6;
+    std::vector<double> k7;
+    std::vector<double> xt;
+    std::vector<double> xNew;
+    std::vector<double> r1;             // Dense output coefficients of the last step.
+    std::vector<double> r2;
+    std::vector<double> r3;
+    std::vector<double> r4;
+    std::vector<double> r5;
+    double InitialStep(CoreProgram& program, double tMax);
+
+public:
+    void Initialize(CoreProgram& program, double t0) override;
+    void Step(CoreProgram& program, double hStep) override;
+    bool IsAdaptive() const override { return true; }
+    void SetTolerance(double rTol, double aTol) override { relTol = rTol; absTol = aTol; }
+    bool Advance(CoreProgram& program, double tMax) override;
+    void Interpolate(double tq, double* xq) const override;
+};
+
+// Implicit BDF of order 2 on the sample time grid, started with implicit Euler. The Newton matrix is
+// sparse: its pattern comes from the program structure and the Jacobian is estimated by colored
+// finite differences, so a step costs in proportion to the nonzeros rather than the square of the states.
+class BDFSolver : public CoreSolver
+{
+private:
+    double relTol = 1e-6;
+    double absTol = 1e-8;
+    SparsePattern pattern;
+    std::vector<double> jac;            // Jacobian values on the pattern.
+    std::vector<std::vector<int>> colorCols;
+    std::vector<int> colPtr;            // Entries of the Jacobian column by column.
+    std::vector<int> colEntry;
+    std::vector<int> colRow;
+    SparseLU lu;
+    double luAlpha = 0.0;               // Factored matrix is I + luAlpha * J.
+    bool jacStale = true;               // Evaluate the Jacobian before the next Newton iteration.
+    bool jacFresh = false;              // Jacobian was evaluated at the current state.
+    bool luValid = false;
+    std::vector<double> xPrev;
+    double hPrev = 0.0;
+    std::vector<double> f0;
+    std::vector<double> ft;
+    std::vector<double> xt;
+    std::vector<double> xNew;
+    std::vector<double> psi;
+    std::vector<double> delta;
+    void UpdateJacobian(CoreProgram& program);
+    bool Newton(CoreProgram& program, double tNew, double hGamma);
+    bool Attempt(CoreProgram& program, double h, int depth);
+
+public:
+    void Initialize(CoreProgram& program, double t0) override;
+    void Step(CoreProgram& program, double h) override;
+    void SetTolerance(double rTol, double aTol) override { relTol = rTol; absTol = aTol; }
+    int GetColorNum() const { return static_cast<int>(colorCols.size()); }
+};
+
+#endif /* CORESOLVER_HPP */
\ No newline at end of file
@@ -0,0 +1,167 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Sparse                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreSparse.hpp"
+#include <set>
+#include <algorithm>
+#include <cmath>
+
+int ColorColumns(const SparsePattern& pattern, std::vector<int>& color)
+{
+    const int n = pattern.n;
+
+    // Rows of each column.
+    std::vector<std::vector<int>> colRows(n);
+    for (int i = 0; i < n; i++)
+    {
+        for (int p = pattern.rowPtr[i]; p < pattern.rowPtr[i + 1]; p++)
+        {
+            colRows[pattern.col[p]].push_back(i);
+        }
+    }
+
+    color.assign(n, -1);
+    std::vector<int> usedBy;            // Last column that marked a color as used.
+    int colorNum = 0;
+    for (int j = 0; j < n; j++)
+    {
+        for (const auto& i : colRows[j])
+        {
+            for (int p = pattern.rowPtr[i]; p < pattern.rowPtr[i + 1]; p++)
+            {
+                const int c = color[pattern.col[p]];
+                if (c >= 0)
+                {
+                    usedBy[c] = j;
+                }
+            }
+        }
+        int c = 0;
+        while (c < colorNum && usedBy[c] == j)
+        {
+            c++;
+        }
+        if (c == colorNum)
+        {
+            colorNum += 1;
+            usedBy.push_back(-1);
+        }
+        color[j] = c;
+    }
+    return colorNum;
+}
+
+void SparseLU::Analyze(const SparsePattern& pattern)
+{
+    n = pattern.n;
+    rowPtr.assign(1, 0);
+    col.clear();
+    diag.assign(n, 0);
+
+    // Symbolic elimination. Row i gets the upper part of every row k < i it has an entry in.
+    for (int i = 0; i < n; i++)
+    {
+        std::set<int> row(pattern.col.begin() + pattern.rowPtr[i], pattern.col.begin() + pattern.rowPtr[i + 1]);
+        row.insert(i);
+        for (auto it = row.begin(); it != row.end() && *it < i; ++it)
+        {
+            const int k = *it;
+            row.insert(col.begin() + diag[k] + 1, col.begin() + rowPtr[k + 1]);
+        }
+        for (const auto& j : row)
+        {
+            if (j == i)
+            {
+                diag[i] = static_cast<int>(col.size());
+            }
+            col.push_back(j);
+        }
+        rowPtr.push_back(static_cast<int>(col.size()));
+    }
+
+    // Both patterns are sorted, so every entry of the matrix is found by a merge.
+    map.assign(pattern.col.size(), 0);
+    for (int i = 0; i < n; i++)
+    {
+        int q = rowPtr[i];
+        for (int p = pattern.rowPtr[i]; p < pattern.rowPtr[i + 1]; p++)
+        {
+            while (col[q] != pattern.col[p])
+            {
+                q++;
+            }
+            map[p] = q;
+        }
+    }
+    val.assign(col.size(), 0.0);
+    work.assign(n, 0.0);
+}
+
+bool SparseLU::Factor(const double* a, double alpha, double beta)
+{
+    std::fill(val.begin(), val.end(), 0.0);
+    for (size_t p = 0; p < map.size(); p++)
+    {
+        val[map[p]] = alpha * a[p];
+    }
+    for (int i = 0; i < n; i++)
+    {
+        val[diag[i]] += beta;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int p = rowPtr[i]; p < rowPtr[i + 1]; p++)
+        {
+            work[col[p]] = val[p];
+        }
+        for (int p = rowPtr[i]; p < diag[i]; p++)
+        {
+            const int k = col[p];
+            const double lik = work[k] / val[diag[k]];
+            work[k] = lik;
+            for (int q = diag[k] + 1; q < rowPtr[k + 1]; q++)
+            {
+                work[col[q]] -= lik * val[q];
+            }
+        }
+        for (int p = rowPtr[i]; p < rowPtr[i + 1]; p++)
+        {
+            val[p] = work[col[p]];
+            work[col[p]] = 0.0;
+        }
+        if (std::abs(val[diag[i]]) < 1e-300)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SparseLU::Solve(double* b) const
+{
+    for (int i = 0; i < n; i++)
+    {
+        double s = b[i];
+        for (int p = rowPtr[i]; p < diag[i]; p++)
+        {
+            s -= val[p] * b[col[p]];
+        }
+        b[i] = s;
+    }
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double s = b[i];
+        for (int p = diag[i] + 1; p < rowPtr[i + 1]; p++)
+        {
+            s -= val[p] * b[col[p]];
+        }
+        b[i] = s / val[diag[i]];
+    }
+}
\ No newline at end of file
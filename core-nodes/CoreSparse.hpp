@@ -0,0 +1,49 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Sparse                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORESPARSE_HPP
+#define CORESPARSE_HPP
+
+#include <vector>
+
+// Compressed sparse row pattern of a square matrix. Column indices are sorted in each row.
+struct SparsePattern
+{
+    int n = 0;
+    std::vector<int> rowPtr;
+    std::vector<int> col;
+    int GetNonzeroNum() const { return static_cast<int>(col.size()); }
+};
+
+// Greedy coloring of structurally orthogonal columns. Columns of the same color share no row,
+// so they can be perturbed together when the matrix is estimated by finite differences.
+int ColorColumns(const SparsePattern& pattern, std::vector<int>& color);
+
+// LU factorization without pivoting on a symbolic pattern computed once, including the fill-in.
+class SparseLU
+{
+private:
+    int n = 0;
+    std::vector<int> rowPtr;
+    std::vector<int> col;
+    std::vector<int> diag;              // Position of the diagonal entry in each row.
+    std::vector<int> map;               // Position of each entry of the analyzed matrix in the factors.
+    std::vector<double> val;            // L (unit diagonal, not stored) and U, row by row.
+    std::vector<double> work;
+
+public:
+    SparseLU() = default;
+    virtual ~SparseLU() = default;
+    void Analyze(const SparsePattern& pattern);
+    bool Factor(const double* a, double alpha, double beta);   // Factors beta * I + alpha * A.
+    void Solve(double* b) const;
+    int GetNonzeroNum() const { return static_cast<int>(col.size()); }
+};
+
+#endif /* CORESPARSE_HPP */
\ No newline at end of file
@@ -0,0 +1,188 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Spatial Index                                                                   *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreSpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+void CoreSpatialIndex::CellRange(const ImRect& rect, int& x0, int& y0, int& x1, int& y1) const
+{
+    x0 = static_cast<int>(std::floor(rect.Min.x / cellSize));
+    y0 = static_cast<int>(std::floor(rect.Min.y / cellSize));
+    x1 = static_cast<int>(std::floor(rect.Max.x / cellSize));
+    y1 = static_cast<int>(std::floor(rect.Max.y / cellSize));
+}
+
+void CoreSpatialIndex::Link(CoreNode* node, const Entry& entry)
+{
+    for (int y = entry.y0; y <= entry.y1; y++)
+    {
+        for (int x = entry.x0; x <= entry.x1; x++)
+        {
+            cells[Key(x, y)].push_back(node);
+        }
+    }
+}
+
+void CoreSpatialIndex::Unlink(const CoreNode* node, const Entry& entry)
+{
+    for (int y = entry.y0; y <= entry.y1; y++)
+    {
+        for (int x = entry.x0; x <= entry.x1; x++)
+        {
+            auto it = cells.find(Key(x, y));
+            if (it == cells.end())
+            {
+                continue;
+            }
+            auto& cell = it->second;
+            auto pos = std::find(cell.begin(), cell.end(), node);
+            if (pos != cell.end())
+            {
+                *pos = cell.back();
+                cell.pop_back();
+            }
+            if (cell.empty() == true)
+            {
+                cells.erase(it);
+            }
+        }
+    }
+}
+
+void CoreSpatialIndex::Insert(CoreNode* node, int order)
+{
+    Entry entry;
+    CellRange(node->GetRectBounds(), entry.x0, entry.y0, entry.x1, entry.y1);
+    entry.order = order;
+    entry.stamp = stamp;
+    entries[node] = entry;
+    Link(node, entry);
+}
+
+void CoreSpatialIndex::Remove(CoreNode* node)
+{
+    auto it = entries.find(node);
+    if (it == entries.end())
+    {
+        return;
+    }
+    Unlink(node, it->second);
+    entries.erase(it);
+}
+
+void CoreSpatialIndex::Clear()
+{
+    cells.clear();
+    entries.clear();
+}
+
+void CoreSpatialIndex::Update(CoreNode* node)
+{
+    auto it = entries.find(node);
+    if (it == entries.end())
+    {
+        return;
+    }
+    Entry& entry = it->second;
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+    CellRange(node->GetRectBounds(), x0, y0, x1, y1);
+    if (x0 == entry.x0 && y0 == entry.y0 && x1 == entry.x1 && y1 == entry.y1)
+    {
+        return; // Most moves stay in the same cells.
+    }
+    Unlink(node, entry);
+    entry.x0 = x0;
+    entry.y0 = y0;
+    entry.x1 = x1;
+    entry.y1 = y1;
+    Link(node, entry);
+}
+
+void CoreSpatialIndex::SetOrder(const std::vector<CoreNode*>& nodeVec)
+{
+    for (int i = 0; i < nodeVec.size(); i++)
+    {
+        auto it = entries.find(nodeVec[i]);
+        if (it != entries.end())
+        {
+            it->second.order = i;
+        }
+    }
+}
+
+double CoreSpatialIndex::GetCellNum(const ImRect& rect) const
+{
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+    CellRange(rect, x0, y0, x1, y1);
+    return (static_cast<double>(x1) - x0 + 1.0) * (static_cast<double>(y1) - y0 + 1.0);
+}
+
+void CoreSpatialIndex::Query(const ImRect& rect, std::vector<CoreNode*>& result)
+{
+    result.clear();
+    stamp += 1;
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+    CellRange(rect, x0, y0, x1, y1);
+    if (GetCellNum(rect) > static_cast<double>(cells.size()))
+    {
+        // Zoomed far out, walking the occupied cells is cheaper than walking the rectangle.
+        for (const auto& [key, cell] : cells)
+        {
+            const int x = static_cast<int>(static_cast<unsigned int>(static_cast<unsigned long long>(key) >> 32));
+            const int y = static_cast<int>(static_cast<unsigned int>(key));
+            if (x < x0 || x > x1 || y < y0 || y > y1)
+            {
+                continue;
+            }
+            for (const auto& node : cell)
+            {
+                Entry& entry = entries[node];
+                if (entry.stamp != stamp)
+                {
+                    entry.stamp = stamp;
+                    result.push_back(node);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                auto it = cells.find(Key(x, y));
+                if (it == cells.end())
+                {
+                    continue;
+                }
+                for (const auto& node : it->second)
+                {
+                    Entry& entry = entries[node];
+                    if (entry.stamp != stamp)
+                    {
+                        entry.stamp = stamp;
+                        result.push_back(node);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end(), [this](const CoreNode* a, const CoreNode* b) { return entries[a].order < entries[b].order; });
+}
\ No newline at end of file
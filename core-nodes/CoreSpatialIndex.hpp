@@ -0,0 +1,54 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Spatial Index                                                                   *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORESPATIALINDEX_HPP
+#define CORESPATIALINDEX_HPP
+
+#include "CoreNode.hpp"
+#include <unordered_map>
+
+// Uniform grid over the node bounds, in diagram coordinates. The graph reports node moves,
+// so queries cost the cells under the rectangle instead of the whole node vector.
+class CoreSpatialIndex
+{
+private:
+    struct Entry
+    {
+        int x0;
+        int y0;
+        int x1;
+        int y1;
+        int order;                      // Position in the node vector, the drawing order.
+        unsigned int stamp;             // Last query that returned the node.
+    };
+    float cellSize = 256.0f;
+    std::unordered_map<long long, std::vector<CoreNode*>> cells;
+    std::unordered_map<const CoreNode*, Entry> entries;
+    unsigned int stamp = 0;
+    static long long Key(int x, int y) { return static_cast<long long>(static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32 | static_cast<unsigned int>(y)); }
+    void CellRange(const ImRect& rect, int& x0, int& y0, int& x1, int& y1) const;
+    void Link(CoreNode* node, const Entry& entry);
+    void Unlink(const CoreNode* node, const Entry& entry);
+
+public:
+    CoreSpatialIndex() = default;
+    virtual ~CoreSpatialIndex() = default;
+    void Insert(CoreNode* node, int order);
+    void Remove(CoreNode* node);
+    void Clear();
+    void Update(CoreNode* node);
+    void SetOrder(const std::vector<CoreNode*>& nodeVec);
+
+    // Nodes whose bounds may overlap the rectangle, in drawing order.
+    void Query(const ImRect& rect, std::vector<CoreNode*>& result);
+    size_t GetCellNum() const { return cells.size(); }
+    double GetCellNum(const ImRect& rect) const;    // Cells under the rectangle, occupied or not.
+};
+
+#endif /* CORESPATIALINDEX_HPP */
\ No newline at end of file
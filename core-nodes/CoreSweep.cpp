@@ -0,0 +1,253 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Sweep                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreSweep.hpp"
+#include <random>
+#include <limits>
+#include <chrono>
+#include <cstdlib>
+
+bool SweepParam::Parse(const std::string& text, SweepParam& param)
+{
+    const auto eq = text.find('=');
+    if (eq == std::string::npos || eq == 0)
+    {
+        return false;
+    }
+    param = SweepParam();
+    param.name = text.substr(0, eq);
+    std::vector<std::string> fields;
+    size_t begin = eq + 1;
+    while (true)
+    {
+        const auto end = text.find(':', begin);
+        fields.push_back(text.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+        if (end == std::string::npos)
+        {
+            break;
+        }
+        begin = end + 1;
+    }
+    std::vector<double> values;
+    for (size_t i = 1; i < fields.size(); i++)
+    {
+        char* end = nullptr;
+        values.push_back(std::strtod(fields[i].c_str(), &end));
+        if (fields[i].empty() == true || *end != '\0')
+        {
+            return false;
+        }
+    }
+    if (fields[0] == "range" && values.size() == 3 && values[2] >= 1.0)
+    {
+        param.type = Type::RANGE;
+        param.num = static_cast<int>(values[2]);
+    }
+    else if (fields[0] == "uniform" && values.size() == 2 && values[1] >= values[0])
+    {
+        param.type = Type::UNIFORM;
+    }
+    else if (fields[0] == "normal" && values.size() == 2 && values[1] >= 0.0)
+    {
+        param.type = Type::NORMAL;
+    }
+    else
+    {
+        return false;
+    }
+    param.a = values[0];
+    param.b = values[1];
+    return true;
+}
+
+void SweepStats::Add(double v)
+{
+    n += 1;
+    const double delta = v - mean;
+    mean += delta / n;
+    m2 += delta * (v - mean);
+    min = n == 1 ? v : std::min(min, v);
+    max = n == 1 ? v : std::max(max, v);
+}
+
+void SweepStats::Merge(const SweepStats& other)
+{
+    if (other.n == 0)
+    {
+        return;
+    }
+    if (n == 0)
+    {
+        *this = other;
+        return;
+    }
+    const long long nSum = n + other.n;
+    const double delta = other.mean - mean;
+    mean += delta * other.n / nSum;
+    m2 += other.m2 + delta * delta * n * other.n / nSum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    n = nSum;
+}
+
+bool CoreSweep::Init(const CoreProgram& compiledProgram, const SimSettings& simSettings, const std::vector<SweepParam>& params,
+    long long monteCarloRuns, std::uint64_t randomSeed)
+{
+    program = compiledProgram;
+    settings = simSettings;
+    sweepParams = params;
+    seed = randomSeed;
+    gridNum = 1;
+    mcRuns = 1;
+    error.clear();
+    bool random = false;
+    for (auto& param : sweepParams)
+    {
+        param.index = program.FindParam(param.name);
+        if (param.index < 0)
+        {
+            error = "Unknown parameter \"" + param.name + "\".";
+            return false;
+        }
+        if (param.type == SweepParam::Type::RANGE)
+        {
+            gridNum *= param.num;
+        }
+        else
+        {
+            random = true;
+        }
+    }
+    if (random == true)
+    {
+        mcRuns = std::max(1LL, monteCarloRuns);
+    }
+    signalNum = program.GetSignalNum() - 1;
+    return true;
+}
+
+void CoreSweep::Draw(long long run, std::vector<double>& values) const
+{
+    long long grid = run / mcRuns;
+    std::seed_seq seq{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+        static_cast<std::uint32_t>(run), static_cast<std::uint32_t>(run >> 32) };
+    std::mt19937_64 rng(seq); // Seeded by the run, so results do not depend on the scheduling.
+    values.resize(sweepParams.size());
+    for (size_t i = 0; i < sweepParams.size(); i++)
+    {
+        const SweepParam& param = sweepParams[i];
+        if (param.type == SweepParam::Type::RANGE)
+        {
+            const long long k = grid % param.num;
+            grid /= param.num;
+            values[i] = param.num == 1 ? param.a : param.a + (param.b - param.a) * k / (param.num - 1);
+        }
+        else if (param.type == SweepParam::Type::UNIFORM)
+        {
+            values[i] = std::uniform_real_distribution<double>(param.a, param.b)(rng);
+        }
+        else
+        {
+            values[i] = std::normal_distribution<double>(param.a, param.b)(rng);
+        }
+    }
+}
+
+bool CoreSweep::Run(CorePool& pool)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const int threadNum = pool.GetThreadNum();
+    struct Worker
+    {
+        CoreSimulation simulation;
+        std::vector<double> values;
+        std::vector<double> runMin;     // Envelope of the current run, added to the summary if it succeeds.
+        std::vector<double> runMax;
+        std::vector<SweepSummary> summary;
+        long long failedNum = 0;
+    };
+    std::vector<Worker> workers(threadNum);
+    SweepSummary empty;
+    empty.trajMin = std::numeric_limits<double>::infinity();
+    empty.trajMax = -std::numeric_limits<double>::infinity();
+    for (auto& worker : workers)
+    {
+        if (worker.simulation.Init(program, settings) == false)
+        {
+            error = worker.simulation.GetError();
+            return false;
+        }
+        worker.summary.assign(signalNum + 1, empty);
+    }
+
+    const int rowSize = GetRowSize();
+    runValues.assign(GetRunNum() * rowSize, std::numeric_limits<double>::quiet_NaN());
+    pool.ParallelFor(GetRunNum(), [&](long long run, int w)
+    {
+        Worker& worker = workers[w];
+        CoreSimulation& simulation = worker.simulation;
+        Draw(run, worker.values);
+        for (size_t i = 0; i < sweepParams.size(); i++)
+        {
+            simulation.SetParam(sweepParams[i].index, worker.values[i]);
+        }
+        double* row = runValues.data() + run * rowSize;
+        std::copy(worker.values.begin(), worker.values.end(), row);
+        if (simulation.Restart() == false)
+        {
+            worker.failedNum += 1;
+            return;
+        }
+        const auto& signals = simulation.GetProgram().GetSignals();
+        worker.runMin.assign(signals.begin(), signals.end());
+        worker.runMax.assign(signals.begin(), signals.end());
+        bool finite = true;
+        auto track = [&]()
+        {
+            for (int i = 1; i <= signalNum; i++)
+            {
+                finite = finite && std::isfinite(signals[i]);
+                worker.runMin[i] = std::min(worker.runMin[i], signals[i]);
+                worker.runMax[i] = std::max(worker.runMax[i], signals[i]);
+            }
+        };
+        track();
+        while (simulation.Step() == true)
+        {
+            track();
+        }
+        if (simulation.GetError().empty() == false || finite == false) // Failed or diverged.
+        {
+            worker.failedNum += 1;
+            return;
+        }
+        for (int i = 1; i <= signalNum; i++)
+        {
+            worker.summary[i].final.Add(signals[i]);
+            worker.summary[i].trajMin = std::min(worker.summary[i].trajMin, worker.runMin[i]);
+            worker.summary[i].trajMax = std::max(worker.summary[i].trajMax, worker.runMax[i]);
+            row[sweepParams.size() + i - 1] = signals[i];
+        }
+    });
+
+    summary.assign(signalNum + 1, empty);
+    failedNum = 0;
+    for (const auto& worker : workers)
+    {
+        for (int i = 1; i <= signalNum; i++)
+        {
+            summary[i].final.Merge(worker.summary[i].final);
+            summary[i].trajMin = std::min(summary[i].trajMin, worker.summary[i].trajMin);
+            summary[i].trajMax = std::max(summary[i].trajMax, worker.summary[i].trajMax);
+        }
+        failedNum += worker.failedNum;
+    }
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Sweep                                                                           *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef CORESWEEP_HPP
+#define CORESWEEP_HPP
+
+#include "CoreSimulation.hpp"
+#include "CorePool.hpp"
+#include <cstdint>
+#include <cmath>
+
+// A parameter varied over the runs, "Node.param=range:a:b:n", "uniform:a:b" or "normal:mean:sigma".
+struct SweepParam
+{
+    enum class Type
+    {
+        RANGE,
+        UNIFORM,
+        NORMAL
+    };
+    std::string name;
+    Type type = Type::RANGE;
+    double a = 0.0;
+    double b = 0.0;
+    int num = 1;                        // Points of a range.
+    int index = -1;                     // In the parameter arena.
+    static bool Parse(const std::string& text, SweepParam& param);
+};
+
+// Running statistics, merged across workers (Welford, Chan et al.).
+struct SweepStats
+{
+    long long n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    void Add(double v);
+    void Merge(const SweepStats& other);
+    double GetStd() const { return n > 1 ? std::sqrt(m2 / (n - 1)) : 0.0; }
+};
+
+// Final value and extremes of a signal over all runs.
+struct SweepSummary
+{
+    SweepStats final;
+    double trajMin = 0.0;
+    double trajMax = 0.0;
+};
+
+// Runs a compiled program many times with varied parameters. Ranges form a grid; every grid point
+// is run with mcRuns random draws of the distributed parameters. Each worker keeps one simulation
+// and only overwrites the parameter arena between runs.
+class CoreSweep
+{
+private:
+    CoreProgram program;
+    SimSettings settings;
+    std::vector<SweepParam> sweepParams;
+    long long gridNum = 1;
+    long long mcRuns = 1;
+    std::uint64_t seed = 0;
+    int signalNum = 0;                  // Without the zero signal.
+    std::vector<double> runValues;      // Parameter values and final signals of every run, row by row. NaN if the run failed.
+    std::vector<SweepSummary> summary;
+    long long failedNum = 0;
+    std::string error;
+    double elapsed = 0.0;
+    void Draw(long long run, std::vector<double>& values) const;
+
+public:
+    CoreSweep() = default;
+    virtual ~CoreSweep() = default;
+    bool Init(const CoreProgram& compiledProgram, const SimSettings& simSettings, const std::vector<SweepParam>& params,
+        long long monteCarloRuns, std::uint64_t randomSeed);
+    bool Run(CorePool& pool);
+
+    std::string GetError() const { return error; }
+    long long GetRunNum() const { return gridNum * mcRuns; }
+    long long GetFailedNum() const { return failedNum; }
+    double GetElapsed() const { return elapsed; }
+    const std::vector<SweepParam>& GetParams() const { return sweepParams; }
+    int GetRowSize() const { return static_cast<int>(sweepParams.size()) + signalNum; }
+    const double* GetRow(long long run) const { return runValues.data() + run * GetRowSize(); }
+    const std::vector<SweepSummary>& GetSummary() const { return summary; } // Indexed like the signal arena.
+};
+
+#endif /* CORESWEEP_HPP */
\ No newline at end of file
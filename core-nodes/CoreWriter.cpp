@@ -0,0 +1,141 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Writer                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "CoreWriter.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <io.h>
+static int SyncFile(std::FILE* file) { return _commit(_fileno(file)); }
+static void SyncDirectory(const std::filesystem::path&) {} // Renames are journaled by NTFS.
+#else
+#include <fcntl.h>
+#include <unistd.h>
+static int SyncFile(std::FILE* file) { return fsync(fileno(file)); }
+static void SyncDirectory(const std::filesystem::path& directory)
+{
+    // Makes the rename itself durable.
+    const int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+#endif
+
+CoreWriter::~CoreWriter()
+{
+    if (worker.joinable() == true)
+    {
+        worker.join(); // Let a running save finish, the old file has been replaced or is intact.
+    }
+}
+
+bool CoreWriter::Start(std::unique_ptr<CoreBinaryWriter> records, const std::string& filePath, bool binaryFile)
+{
+    if (worker.joinable() == true)
+    {
+        return false;
+    }
+    snapshot = std::move(records);
+    binary = binaryFile;
+    path = filePath;
+    error.clear();
+    running.store(true, std::memory_order_release);
+    worker = std::thread(&CoreWriter::Work, this);
+    return true;
+}
+
+bool CoreWriter::IsFinished()
+{
+    if (worker.joinable() == false || IsRunning() == true)
+    {
+        return false;
+    }
+    worker.join();
+    return true;
+}
+
+void CoreWriter::Work()
+{
+    data = snapshot->GetData();
+    snapshot.reset();
+    bool ok = true;
+    if (binary == false)
+    {
+        // The document is built here from the records, the model may have changed since.
+        CoreBinaryReader reader;
+        ok = reader.Open(data.data(), data.size());
+        if (ok == true)
+        {
+            std::ostringstream stream;
+            reader.CreateDoc().save(stream, PUGIXML_TEXT("  "));
+            data = stream.str();
+        }
+        else
+        {
+            error = reader.GetError();
+        }
+    }
+    if (ok == true)
+    {
+        WriteFile(path, data, error);
+    }
+    data.clear();
+    running.store(false, std::memory_order_release);
+}
+
+bool CoreWriter::WriteFile(const std::string& filePath, const std::string& data, std::string& error)
+{
+    const std::filesystem::path target(filePath);
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+    std::FILE* file = std::fopen(temp.string().c_str(), "wb");
+    if (file == nullptr)
+    {
+        error = "Cannot create " + temp.string() + ": " + std::strerror(errno);
+        return false;
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = ok && FlushFile(file) == true;
+    if (ok == false)
+    {
+        error = "Cannot write " + temp.string() + ": " + std::strerror(errno);
+    }
+    if (std::fclose(file) != 0 && ok == true)
+    {
+        error = "Cannot close " + temp.string() + ": " + std::strerror(errno);
+        ok = false;
+    }
+    if (ok == false)
+    {
+        std::remove(temp.string().c_str());
+        return false;
+    }
+    std::error_code code;
+    std::filesystem::rename(temp, target, code); // Replaces the target in one step.
+    if (code)
+    {
+        error = "Cannot replace " + filePath + ": " + code.message();
+        std::remove(temp.string().c_str());
+        return false;
+    }
+    SyncDirectory(target.parent_path());
+    return true;
+}
+
+bool CoreWriter::FlushFile(std::FILE* file)
+{
+    return std::fflush(file) == 0 && SyncFile(file) == 0;
+}
\ No newline at end of file
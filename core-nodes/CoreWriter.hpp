@@ -0,0 +1,53 @@
+/******************************************************************************************
+*                                                                                         *
+*    Core Writer                                                                          *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef COREWRITER_HPP
+#define COREWRITER_HPP
+
+#include "CoreBinary.hpp"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Saves documents on a worker thread. The caller hands over the records of the project, so the
+// editor keeps changing the model while the records are packed or formatted as XML and written. The file is written
+// next to the target, flushed to the disk and renamed over it, a failed save leaves the old file intact.
+// Start and the getters are called from the UI thread.
+class CoreWriter
+{
+private:
+    std::thread worker;
+    std::atomic<bool> running{ false };
+    std::unique_ptr<CoreBinaryWriter> snapshot;
+    bool binary = false;
+    std::string data;                       // Contents of the file.
+    std::string path;
+    std::string error;
+    void Work();
+
+public:
+    CoreWriter() = default;
+    CoreWriter(const CoreWriter&) = delete;
+    CoreWriter& operator=(const CoreWriter&) = delete;
+    virtual ~CoreWriter();
+    bool Start(std::unique_ptr<CoreBinaryWriter> records, const std::string& filePath, bool binaryFile); // False while a save is running.
+    bool IsRunning() const { return running.load(std::memory_order_acquire); }
+    bool IsFinished();                      // True once per save, after the worker is done.
+
+    // Valid after IsFinished returns true.
+    const std::string& GetPath() const { return path; }
+    const std::string& GetError() const { return error; } // Empty on success.
+
+    static bool WriteFile(const std::string& filePath, const std::string& data, std::string& error);
+    static bool FlushFile(std::FILE* file); // Through the buffers of the library and of the system, to the disk.
+};
+
+#endif /* COREWRITER_HPP */
\ No newline at end of file
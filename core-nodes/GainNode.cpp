@@ -16,21 +16,16 @@ void GainNode::Build()
     BuildGeometry();
 }
 
-void GainNode::DrawProperties(const std::vector<CoreNode*>& coreNodeVec)
+void GainNode::Compile(NodeKernel& kernel) const
 {
-    ImGui::Text(GetLibName().c_str());
-    ImGui::Separator();
-    ImGui::Text("Outputs input times parameter.");
-    ImGui::NewLine();
-    ImGui::Text("Parameters");
-    ImGui::Separator();
-    EditName(coreNodeVec);
-    gain.Draw(modifFlag);
+    kernel.output = &GainNode::Output;
+    kernel.param = { gain.Get() };
+    kernel.paramName = { gain.GetName() };
 }
 
-void GainNode::SaveProperties(pugi::xml_node& xmlNode)
+void GainNode::Output(const StepArgs& args)
 {
-    SaveDouble(xmlNode, "gain", gain.Get());
+    args.out[0] = args.param[0] * args.In(0);
 }
 
 void GainNode::LoadProperties(const pugi::xml_node& xmlNode)
@@ -19,11 +19,13 @@ public:
     ~GainNode() override = default;
 
     void Build() override;
-    void DrawProperties(const std::vector<CoreNode*>& coreNodeVec) override;
+    void Compile(NodeKernel& kernel) const override;
+    std::string GetDescription() const override { return "Outputs input times parameter."; }
+    std::vector<NodeParamDouble*> GetParams() override { return { &gain }; }
 
-    void SaveProperties(pugi::xml_node& xmlNode) override;
     void LoadProperties(const pugi::xml_node& xmlNode) override;
 private:
+    static void Output(const StepArgs& args);
     NodeParamDouble gain{"gain", 1.0};
 };
 
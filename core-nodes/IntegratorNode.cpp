@@ -0,0 +1,49 @@
+/******************************************************************************************
+*                                                                                         *
+*    Integrator Node                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "IntegratorNode.hpp"
+
+void IntegratorNode::Build()
+{
+    AddInput(CoreNodeInput("Input", PortType::In, PortDataType::Double));
+    AddInput(CoreNodeInput("Ic", PortType::Ic, PortDataType::Double));
+    AddOutput(CoreNodeOutput("Output", PortType::Out, PortDataType::Double));
+    BuildGeometry();
+}
+
+void IntegratorNode::Compile(NodeKernel& kernel) const
+{
+    kernel.init = &IntegratorNode::Init;
+    kernel.output = &IntegratorNode::Output;
+    kernel.derivative = &IntegratorNode::Derivative;
+    kernel.stateNum = 1;
+    kernel.feedthrough = false;
+    kernel.param = { ic.Get() };
+    kernel.paramName = { ic.GetName() };
+}
+
+void IntegratorNode::Init(const StepArgs& args)
+{
+    args.x[0] = args.IsLinked(1) ? args.In(1) : args.param[0];
+}
+
+void IntegratorNode::Output(const StepArgs& args)
+{
+    args.out[0] = args.x[0];
+}
+
+void IntegratorNode::Derivative(const StepArgs& args)
+{
+    args.dx[0] = args.In(0);
+}
+
+void IntegratorNode::LoadProperties(const pugi::xml_node& xmlNode)
+{
+    ic.Set(LoadDouble(xmlNode, "ic"));
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+/******************************************************************************************
+*                                                                                         *
+*    Integrator Node                                                                      *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#ifndef INTEGRATORNODE_HPP
+#define INTEGRATORNODE_HPP
+
+#include "CoreNode.hpp"
+
+class IntegratorNode : public CoreNode
+{
+public:
+    explicit IntegratorNode(const std::string& uniqueName) : CoreNode(uniqueName, "Integrator", NodeType::Generic, ImColor(0.2f, 0.5f, 0.3f, 0.0f)) {};
+    ~IntegratorNode() override = default;
+
+    void Build() override;
+    void Compile(NodeKernel& kernel) const override;
+    std::string GetDescription() const override { return "Integrates the input in time.\nInitial condition is the Ic input if linked,\notherwise the ic parameter."; }
+    std::vector<NodeParamDouble*> GetParams() override { return { &ic }; }
+
+    void LoadProperties(const pugi::xml_node& xmlNode) override;
+private:
+    static void Init(const StepArgs& args);
+    static void Output(const StepArgs& args);
+    static void Derivative(const StepArgs& args);
+    NodeParamDouble ic{ "ic", 0.0 };
+};
+
+#endif /* INTEGRATORNODE_HPP */
\ No newline at end of file
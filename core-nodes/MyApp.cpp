@@ -17,8 +17,11 @@ void MyApp::Update()
     ImGui::PushFont(fontLarge);
     Notifier::Draw();
     ImGui::PopFont();
+    PollSimulation();
+    PollSave();
     UndoRedoSave();
     DrawSaveModal();
+    DrawRecoveryModal();
     DrawAbout();
 }
 
@@ -32,7 +35,30 @@ void MyApp::SelectTab(const char* windowName) const
 MyApp::MyApp() : GuiApp("MyApp")
 {
     SetTitle("untitled");
+    SetTextSizeFunc([](const std::string& text) { return ImGui::CalcTextSize(text.c_str()); });
     coreDiagram = std::make_unique<CoreDiagram>();
+
+    // Journals left by a session that did not close, the newest one is offered.
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> journals;
+    std::error_code code;
+    for (const auto& journal : CoreRecovery::FindJournals())
+    {
+        journals.emplace_back(std::filesystem::last_write_time(journal, code), journal);
+    }
+    std::sort(journals.begin(), journals.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (const auto& journal : journals)
+    {
+        if (OfferRecovery(journal.second) == true)
+        {
+            return;
+        }
+    }
+    StartRecovery();
+}
+
+MyApp::~MyApp()
+{
+    recovery.Close(); // A clean exit leaves nothing to recover.
 }
 
 void MyApp::Dockspace()
@@ -81,8 +107,7 @@ void MyApp::Dockspace()
     ImGui::End();
 
     ImGui::Begin("Simulation", nullptr, ImGuiWindowFlags_None);
-    ImGui::Text("Text");
-    ImGui::Text("(%.1f FPS)", ImGui::GetIO().Framerate);
+    DrawSimulation();
     ImGui::End();
 
     ImGui::Begin("Library", nullptr, ImGuiWindowFlags_None);
@@ -106,8 +131,240 @@ void MyApp::Dockspace()
         SelectTab("Simulation");
         initialSetup = true;
         ImGui::SetWindowFocus("Diagram");
-        ResetDocDeque();
+        ResetHistory();
+    }
+}
+
+void MyApp::DrawSimulation()
+{
+    ImGui::Text("(%.1f FPS)", ImGui::GetIO().Framerate);
+    ImGui::NewLine();
+    ImGui::Text("Settings");
+    ImGui::Separator();
+
+    auto iSolver = static_cast<int>(simSettings.solver);
+    ImGui::AlignTextToFramePadding();
+    ImGui::Text("solver");
+    ImGui::SameLine(100.0f);
+    ImGui::SetNextItemWidth(140.0f);
+    if (ImGui::BeginCombo("##solver", iSolver < solverTypeNames.size() ? solverTypeNames.at(iSolver).c_str() : "Unknown"))
+    {
+        for (int i = 1; i < solverTypeNames.size(); i++)
+        {
+            if (ImGui::Selectable(solverTypeNames.at(i).c_str(), i == iSolver) && i != iSolver)
+            {
+                simSettings.solver = static_cast<SolverType>(i);
+                simModifFlag = true;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::AlignTextToFramePadding();
+    ImGui::Text("sampleTime");
+    ImGui::SameLine(100.0f);
+    ImGui::SetNextItemWidth(140.0f);
+    if (ImGui::InputDouble("##sampleTime", &simSettings.sampleTime, 0.0, 0.0, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
+    {
+        simModifFlag = true;
+    }
+    ImGui::AlignTextToFramePadding();
+    ImGui::Text("stopTime");
+    ImGui::SameLine(100.0f);
+    ImGui::SetNextItemWidth(140.0f);
+    if (ImGui::InputDouble("##stopTime", &simSettings.stopTime, 0.0, 0.0, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
+    {
+        simModifFlag = true;
+    }
+    ImGui::AlignTextToFramePadding();
+    ImGui::Text("speed");
+    ImGui::SameLine(100.0f);
+    ImGui::SetNextItemWidth(140.0f);
+    if (ImGui::BeginCombo("##speed", simSettings.speed.c_str()))
+    {
+        for (const auto& speedName : speedNames)
+        {
+            if (ImGui::Selectable(speedName.c_str(), speedName == simSettings.speed) && speedName != simSettings.speed)
+            {
+                simSettings.speed = speedName;
+                simModifFlag = true;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    if (simSettings.speed == "scaled")
+    {
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("timeScale");
+        ImGui::SameLine(100.0f);
+        ImGui::SetNextItemWidth(140.0f);
+        if (ImGui::InputDouble("##timeScale", &simSettings.timeScale, 0.0, 0.0, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
+        {
+            simModifFlag = true;
+        }
+    }
+    if (simSettings.solver == SolverType::DoPri5 || simSettings.solver == SolverType::BDF)
+    {
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("relTol");
+        ImGui::SameLine(100.0f);
+        ImGui::SetNextItemWidth(140.0f);
+        if (ImGui::InputDouble("##relTol", &simSettings.relTol, 0.0, 0.0, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
+        {
+            simModifFlag = true;
+        }
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("absTol");
+        ImGui::SameLine(100.0f);
+        ImGui::SetNextItemWidth(140.0f);
+        if (ImGui::InputDouble("##absTol", &simSettings.absTol, 0.0, 0.0, "%.15g", ImGuiInputTextFlags_EnterReturnsTrue))
+        {
+            simModifFlag = true;
+        }
+    }
+
+    ImGui::NewLine();
+    if (runner.IsRunning() == true)
+    {
+        if (ImGui::Button(u8"\ue047 Stop", ImVec2(80, 0)))
+        {
+            runner.RequestStop();
+        }
+    }
+    else if (ImGui::Button(u8"\ue1c4 Run", ImVec2(80, 0)))
+    {
+        RunSimulation();
+    }
+    DrawSignals();
+}
+
+void MyApp::DrawSignals()
+{
+    if (signalNames.empty() == true)
+    {
+        return;
+    }
+    const SimSnapshot& snapshot = runner.GetSnapshot();
+    const double stopTime = runner.GetSettings().stopTime;
+    ImGui::SameLine();
+    const float fraction = stopTime > 0.0 ? static_cast<float>(snapshot.time / stopTime) : 1.0f;
+    const std::string overlay = "t = " + std::to_string(snapshot.time);
+    ImGui::ProgressBar(fraction, ImVec2(-FLT_MIN, 0), overlay.c_str());
+
+    if (runner.GetSettings().GetTimeScale() > 0.0)
+    {
+        DrawPacing(snapshot.pacer);
+    }
+
+    ImGui::NewLine();
+    ImGui::Text("Signals");
+    ImGui::Separator();
+    if (snapshot.signals.size() != signalNames.size())
+    {
+        return;
+    }
+    if (ImGui::BeginTable("##signals", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupColumn("name");
+        ImGui::TableSetupColumn("value");
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(signalNames.size()) - 1); // Skip the zero signal.
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart + 1; i < clipper.DisplayEnd + 1; i++)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(signalNames[i].c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.6g", snapshot.signals[i]);
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void MyApp::DrawPacing(const PacerStats& stats) const
+{
+    ImGui::NewLine();
+    ImGui::Text("Pacing");
+    ImGui::Separator();
+    ImGui::Text("overruns    %lld / %lld", stats.overruns, stats.samples);
+    ImGui::Text("lateness    %.1f us", stats.lateness * 1e6);
+    ImGui::Text("worst       %.1f us", stats.latenessMax * 1e6);
+    std::array<float, PacerStats::binNum> bins{};
+    for (int i = 0; i < PacerStats::binNum; i++)
+    {
+        bins[i] = static_cast<float>(stats.histogram[i]);
+    }
+    ImGui::PlotHistogram("##jitter", bins.data(), PacerStats::binNum, 0, "jitter", 0.0f, FLT_MAX, ImVec2(-FLT_MIN, 60.0f));
+    if (ImGui::IsItemHovered() == true)
+    {
+        ImGui::BeginTooltip();
+        for (int i = 0; i < PacerStats::binNum; i++)
+        {
+            if (i < PacerStats::binNum - 1)
+            {
+                ImGui::Text("< %7.0f us  %lld", PacerStats::binEdges[i] * 1e6, stats.histogram[i]);
+            }
+            else
+            {
+                ImGui::Text(">= %6.0f us  %lld", PacerStats::binEdges[i - 1] * 1e6, stats.histogram[i]);
+            }
+        }
+        ImGui::EndTooltip();
+    }
+}
+
+void MyApp::RunSimulation()
+{
+    CoreProgram program;
+    if (coreDiagram->Compile(program) == false)
+    {
+        return;
+    }
+    // The runner works on its own copy of the program, the diagram stays editable.
+    if (runner.Start(program, simSettings) == false)
+    {
+        Notifier::Add(Notif(Notif::Type::ERROR, "Simulation failed!", runner.GetSimulation().GetError(), 5.0f));
+        return;
+    }
+    signalNames.clear();
+    for (int i = 0; i < program.GetSignalNum(); i++)
+    {
+        signalNames.push_back(program.GetSignalName(i));
+    }
+}
+
+void MyApp::PollSimulation()
+{
+    if (runner.IsFinished() == false)
+    {
+        return;
     }
+    const CoreSimulation& simulation = runner.GetSimulation();
+    if (simulation.GetError().empty() == false)
+    {
+        Notifier::Add(Notif(Notif::Type::ERROR, "Simulation failed!", simulation.GetError(), 5.0f));
+        return;
+    }
+    if (runner.IsStopped() == true)
+    {
+        Notifier::Add(Notif(Notif::Type::INFO, "Simulation stopped", "t = " + std::to_string(simulation.GetTime()) + " s."));
+        return;
+    }
+    const SimSettings& settings = simulation.GetSettings();
+    std::string content = std::to_string(simulation.GetStepNum()) + " samples, " + std::to_string(simulation.GetProgram().GetStateNum()) +
+        " states in " + std::to_string(runner.GetElapsed()) + " s.";
+    if (settings.solver == SolverType::DoPri5 || settings.solver == SolverType::BDF)
+    {
+        const SolverStats* stats = simulation.GetSolverStats();
+        content += "\n" + std::to_string(stats->accepted) + " accepted, " + std::to_string(stats->rejected) + " rejected steps.";
+        if (settings.solver == SolverType::BDF)
+        {
+            content += "\n" + std::to_string(stats->jacobians) + " Jacobian evaluations.";
+        }
+    }
+    Notifier::Add(Notif(Notif::Type::SUCCESS, "Simulation completed", content));
 }
 
 void MyApp::Menu()
@@ -158,6 +415,10 @@ void MyApp::MenuFile()
         {
             SaveProject(true);
         }
+        if (ImGui::MenuItem(u8"\ueb60 Save Binary As...", nullptr, false, true))
+        {
+            SaveProject(true, true);
+        }
         ImGui::Separator();
         if (ImGui::MenuItem(u8"\ue9ba Exit", nullptr, false, true))
         {
@@ -216,19 +477,28 @@ void MyApp::DrawFileDialog()
         }
         else if (fileDialog.GetType() == FileDialog::Type::SAVE)
         {
-            SaveToFile(fileDialog.GetFileName().string(), fileDialog.GetResultPath().string());
+            SaveToFile(fileDialog.GetFileName().string(), fileDialog.GetResultPath().string(), saveBinary);
         }
     }
 }
 
 void MyApp::NewProject()
+{
+    ResetProject();
+    StartRecovery();
+    Notifier::Add(Notif(Notif::Type::INFO, "New"));
+}
+
+void MyApp::ResetProject()
 {
     SetTitle("new");
     hasFile = false;
+    binaryFile = false;
     SetAsterisk(false);
     coreDiagram = std::make_unique<CoreDiagram>();
-    ResetDocDeque();
-    Notifier::Add(Notif(Notif::Type::INFO, "New"));
+    simSettings = SimSettings();
+    projectNum += 1;
+    ResetHistory();
 }
 
 void MyApp::OpenProject()
@@ -283,29 +553,20 @@ void MyApp::DrawSaveModal()
     }
 }
 
-pugi::xml_document MyApp::CreateDoc() const
+std::unique_ptr<CoreBinaryWriter> MyApp::CreateSnapshot() const
 {
-    pugi::xml_document doc;
-    auto declarationNode = doc.append_child(pugi::node_declaration);
-    declarationNode.append_attribute("version") = "1.0";
-    declarationNode.append_attribute("encoding") = "ISO-8859-1";
-    declarationNode.append_attribute("standalone") = "yes";
-
-    auto root = doc.append_child("core-nodes");
-    root.append_attribute("version").set_value("v0.1.0");
-    auto sim = root.append_child("simulation");
-    sim.append_attribute("solver").set_value(1);
-    sim.append_attribute("sampleTime").set_value(0.01);
-    sim.append_attribute("stopTime").set_value(5.0);
-    sim.append_attribute("speed").set_value("realTime");
-    coreDiagram->Save(root);
-    return doc;
+    auto snapshot = std::make_unique<CoreBinaryWriter>();
+    snapshot->GetHeader().docVersion = snapshot->AddString("v0.1.0");
+    simSettings.Save(*snapshot);
+    coreDiagram->Save(*snapshot);
+    return snapshot;
 }
 
-void MyApp::SaveProject(bool saveAs)
+void MyApp::SaveProject(bool saveAs, bool binary)
 {
     if (saveAs == true || hasFile == false)
     {
+        saveBinary = saveAs == true ? binary : binaryFile;
         fileDialogOpen = true;
         fileDialog.SetType(FileDialog::Type::SAVE);
         fileDialog.SetFileName("untitled");
@@ -313,60 +574,176 @@ void MyApp::SaveProject(bool saveAs)
     }
     else
     {
-        SaveToFile(GetTitle(), filePath.string());
+        SaveToFile(GetTitle(), filePath.string(), binaryFile);
     }
 }
 
-void MyApp::SaveToFile(const std::string& fName, const std::string& fPath)
+void MyApp::SaveToFile(const std::string& fName, const std::string& fPath, bool binary)
 {
-    auto doc = CreateDoc();
-    if (doc.save_file(fPath.c_str(), PUGIXML_TEXT("  ")))
+    // The records are flat copies of the model, the writer thread packs them or builds the document from them.
+    const bool started = writer.Start(CreateSnapshot(), fPath, binary);
+    if (started == false)
     {
-        filePath = fPath;
-        hasFile = true;
-        SetTitle(fName);
-        SetAsterisk(false);
-        iSavedDoc = iCurrentDoc;
-        Notifier::Add(Notif(Notif::Type::SUCCESS, "Saved"));
+        Notifier::Add(Notif(Notif::Type::WARNING, "Save in progress", "Try again when the current save is done.", 5.0f));
+        return;
     }
-    else
+    savingName = fName;
+    savingProjectNum = projectNum;
+    savingBinary = binary;
+    coreDiagram->GetJournal().MarkSaved();
+    recovery.Mark();
+}
+
+void MyApp::PollSave()
+{
+    if (writer.IsFinished() == false)
+    {
+        return;
+    }
+    if (writer.GetError().empty() == false)
+    {
+        if (savingProjectNum == projectNum)
+        {
+            coreDiagram->GetJournal().MarkUnsaved();
+            recovery.Unmark();
+            SetAsterisk(true);
+        }
+        Notifier::Add(Notif(Notif::Type::ERROR, "Save failed", writer.GetError(), 5.0f));
+        return;
+    }
+    if (savingProjectNum == projectNum)
     {
-        Notifier::Add(Notif(Notif::Type::ERROR, "Save failed"));
+        filePath = writer.GetPath();
+        hasFile = true;
+        binaryFile = savingBinary;
+        SetTitle(savingName);
+        SetAsterisk(coreDiagram->GetJournal().IsSaved() == false);
+        StartRecovery(); // On top of the file just written.
     }
+    Notifier::Add(Notif(Notif::Type::SUCCESS, "Saved"));
 }
 
 void MyApp::LoadDoc(const pugi::xml_document* doc)
 {
     pugi::xml_node root = doc->document_element();
-    // TODO read simulation related parameters here.
+    simSettings.Load(root);
     coreDiagram = std::make_unique<CoreDiagram>();
     coreDiagram->Load(root);
 }
 
-void MyApp::LoadFromFile()
+void MyApp::LoadBinary(const CoreBinaryReader& reader)
 {
-    auto fPath = fileDialog.GetResultPath().string();
-    auto fNameWFormat = fileDialog.GetFileName().string();
-    auto fNameWoFormat = fNameWFormat.substr(0, fNameWFormat.rfind("."));
-    pugi::xml_document doc;
-    pugi::xml_parse_result result = doc.load_file(fPath.c_str(), pugi::parse_default | pugi::parse_declaration);
-    if (result)
-    {
-        // TODO check version.
-        LoadDoc(&doc);
-        ResetDocDeque();
-        filePath = fileDialog.GetResultPath();
+    simSettings.Load(reader);
+    coreDiagram = std::make_unique<CoreDiagram>();
+    coreDiagram->Load(reader);
+}
+
+bool MyApp::LoadProject(const std::filesystem::path& path)
+{
+    const auto fPath = path.string();
+
+    // Both formats use the extension, the magic bytes tell them apart.
+    const bool binary = CoreBinaryReader::IsBinary(fPath);
+    bool loaded = false;
+    std::string error;
+    if (binary == true)
+    {
+        CoreBinaryReader reader;
+        loaded = reader.Open(fPath);
+        if (loaded == true)
+        {
+            LoadBinary(reader);
+        }
+        else
+        {
+            error = reader.GetError();
+        }
+    }
+    else
+    {
+        pugi::xml_document doc;
+        loaded = static_cast<bool>(doc.load_file(fPath.c_str(), pugi::parse_default | pugi::parse_declaration));
+        if (loaded == true)
+        {
+            // TODO check version.
+            LoadDoc(&doc);
+        }
+    }
+    if (loaded == true)
+    {
+        binaryFile = binary;
+        projectNum += 1;
+        ResetHistory();
+        filePath = path;
         hasFile = true;
-        SetTitle(fNameWoFormat);
+        SetTitle(path.stem().string());
         SetAsterisk(false);
         Notifier::Add(Notif(Notif::Type::SUCCESS, "Loaded"));
     }
     else
     {
-        Notifier::Add(Notif(Notif::Type::ERROR, "Load failed"));
+        Notifier::Add(Notif(Notif::Type::ERROR, "Load failed", error, 5.0f));
+    }
+    return loaded;
+}
+
+void MyApp::LoadFromFile()
+{
+    const auto path = fileDialog.GetResultPath();
+    if (LoadProject(path) == true && OfferRecovery(CoreRecovery::GetRecoveryPath(path.string())) == false)
+    {
+        StartRecovery();
     }
 }
 
+class MyApp::SettingsEdit : public CoreCommand
+{
+private:
+    MyApp& app;
+    SimSettings before;
+    SimSettings after;
+
+public:
+    SettingsEdit(MyApp& app, const SimSettings& before, const SimSettings& after) : app(app), before(before), after(after) {}
+    void Undo() override { app.simSettings = before; app.simSettingsRecorded = before; }
+    void Redo() override { app.simSettings = after; app.simSettingsRecorded = after; }
+    size_t GetMemory() const override { return sizeof(*this) + before.speed.capacity() + after.speed.capacity(); }
+    void Write(RecoveryRecord& record) const override
+    {
+        record.PutString("settings");
+        WriteSettings(record, before);
+        WriteSettings(record, after);
+    }
+    static std::unique_ptr<CoreCommand> Read(MyApp& app, RecoveryRecord& record)
+    {
+        const SimSettings before = ReadSettings(record);
+        const SimSettings after = ReadSettings(record);
+        return std::make_unique<SettingsEdit>(app, before, after);
+    }
+    static void WriteSettings(RecoveryRecord& record, const SimSettings& settings)
+    {
+        record.Put(static_cast<int32_t>(settings.solver));
+        record.Put(settings.sampleTime);
+        record.Put(settings.stopTime);
+        record.Put(settings.relTol);
+        record.Put(settings.absTol);
+        record.PutString(settings.speed);
+        record.Put(settings.timeScale);
+    }
+    static SimSettings ReadSettings(RecoveryRecord& record)
+    {
+        SimSettings settings;
+        settings.solver = static_cast<SolverType>(record.Get<int32_t>());
+        settings.sampleTime = record.Get<double>();
+        settings.stopTime = record.Get<double>();
+        settings.relTol = record.Get<double>();
+        settings.absTol = record.Get<double>();
+        settings.speed = record.GetString();
+        settings.timeScale = record.Get<double>();
+        return settings;
+    }
+};
+
 void MyApp::UndoRedoSave()
 {
     if (ImGui::IsAnyItemActive() == true)
@@ -374,23 +751,18 @@ void MyApp::UndoRedoSave()
         return;
     }
 
-    // If project modified, add doc. TODO: other modifications
-    if (coreDiagram->GetModifFlag() == true)
+    // Close the edits of the last interaction into one undo step.
+    auto& journal = coreDiagram->GetJournal();
+    if (simModifFlag == true)
     {
-        if (iCurrentDoc < docs.size() - 1)
-        {
-            docs.erase(docs.begin() + iCurrentDoc + 1, docs.end());
-        }
-        docs.emplace_back(CreateDoc());
-        iCurrentDoc += 1;
-        coreDiagram->ResetModifFlag();
-        SetAsterisk(true);
-        if (docs.size() > maxSavedDoc)
-        {
-            docs.pop_front();
-            iCurrentDoc -= 1;
-            iSavedDoc -= 1;
-        }
+        journal.Record(std::make_unique<SettingsEdit>(*this, simSettingsRecorded, simSettings));
+        simSettingsRecorded = simSettings;
+        simModifFlag = false;
+    }
+    if (journal.HasPending() == true)
+    {
+        journal.Commit();
+        SetAsterisk(journal.IsSaved() == false);
         return;
     }
 
@@ -398,19 +770,9 @@ void MyApp::UndoRedoSave()
     const auto& io = ImGui::GetIO();
     if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Z))
     {
-        if (iCurrentDoc > 0)
+        if (coreDiagram->Undo() == true)
         {
-            auto doc = &(docs[iCurrentDoc - 1]);
-            iCurrentDoc -= 1;
-            LoadDoc(doc);
-            if (iCurrentDoc == iSavedDoc)
-            {
-                SetAsterisk(false);
-            }
-            else
-            {
-                SetAsterisk(true);
-            }
+            SetAsterisk(journal.IsSaved() == false);
             Notifier::Add(Notif(Notif::Type::SUCCESS, "Undo"));
             return;
         }
@@ -420,19 +782,9 @@ void MyApp::UndoRedoSave()
     // Redo
     if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_Y))
     {
-        if (iCurrentDoc < docs.size() - 1)
+        if (coreDiagram->Redo() == true)
         {
-            auto doc = &(docs[iCurrentDoc + 1]);
-            iCurrentDoc += 1;
-            LoadDoc(doc);
-            if (iCurrentDoc == iSavedDoc)
-            {
-                SetAsterisk(false);
-            }
-            else
-            {
-                SetAsterisk(true);
-            }
+            SetAsterisk(journal.IsSaved() == false);
             Notifier::Add(Notif(Notif::Type::SUCCESS, "Redo"));
             return;
         }
@@ -440,18 +792,189 @@ void MyApp::UndoRedoSave()
     }
 
     // Save
-    if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_S) && (iSavedDoc != iCurrentDoc || hasFile == false))
+    if (io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_S) && (journal.IsSaved() == false || hasFile == false))
     {
         SaveProject();
     }
 }
 
-void MyApp::ResetDocDeque()
+void MyApp::ResetHistory()
+{
+    coreDiagram->GetJournal().Clear();
+    simSettingsRecorded = simSettings;
+    simModifFlag = false;
+    recovery.Unmark(); // The history of a save in progress belongs to the previous project.
+}
+
+void MyApp::StartRecovery(const std::string& entries)
+{
+    // Next to the project file, an unsaved project keeps it in the working directory.
+    const std::filesystem::path project = hasFile == true ? filePath : std::filesystem::current_path() / "untitled.dxdt";
+    coreDiagram->GetJournal().SetObserver(&recovery);
+    if (recovery.Start(CoreRecovery::GetRecoveryPath(project.string()), hasFile == true ? filePath.string() : std::string(), entries) == false)
+    {
+        Notifier::Add(Notif(Notif::Type::WARNING, "No recovery journal", recovery.GetError(), 5.0f));
+    }
+}
+
+bool MyApp::OfferRecovery(const std::filesystem::path& path)
+{
+    std::string basePath;
+    std::vector<CoreRecovery::Entry> entries;
+    std::string data;
+    std::string error;
+    if (path.string() == recovery.GetPath() || CoreRecovery::Read(path.string(), basePath, entries, data, error) == false)
+    {
+        return false;
+    }
+
+    // The history written with a save is already in the project file, only the edits after it count.
+    bool hasEdits = false;
+    for (const auto& entry : entries)
+    {
+        if (entry.type == CoreRecovery::EntryType::Base)
+        {
+            hasEdits = false;
+        }
+        else if (entry.type == CoreRecovery::EntryType::Command || entry.type == CoreRecovery::EntryType::Undo || entry.type == CoreRecovery::EntryType::Redo)
+        {
+            hasEdits = true;
+        }
+    }
+    if (hasEdits == false)
+    {
+        return false;
+    }
+    recoveryFile = path.string();
+    openRecoveryModal = true;
+    return true;
+}
+
+void MyApp::DrawRecoveryModal()
+{
+    if (openRecoveryModal == true)
+    {
+        ImGui::OpenPopup("Recover?");
+        openRecoveryModal = false;
+    }
+    ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    if (ImGui::BeginPopupModal("Recover?", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::Text("A session that did not close left unsaved edits in\n%s\nDo you want to recover them?", recoveryFile.c_str());
+        ImGui::Separator();
+        if (ImGui::Button("Yes", ImVec2(80, 0)))
+        {
+            RecoverProject();
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("No", ImVec2(80, 0)))
+        {
+            std::error_code code;
+            std::filesystem::remove(recoveryFile, code);
+            StartRecovery();
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+}
+
+void MyApp::RecoverProject()
+{
+    std::string basePath;
+    std::vector<CoreRecovery::Entry> entries;
+    std::string data;
+    std::string error;
+    if (CoreRecovery::Read(recoveryFile, basePath, entries, data, error) == false)
+    {
+        Notifier::Add(Notif(Notif::Type::ERROR, "Recovery failed", error, 5.0f));
+        StartRecovery();
+        return;
+    }
+    if (basePath.empty() == true)
+    {
+        ResetProject(); // The journal of an unsaved project has the path of the new one, it is kept until the replay is written.
+    }
+    else if (LoadProject(basePath) == false)
+    {
+        StartRecovery();
+        return;
+    }
+
+    // The entries are written back as they are, the replay itself is not recorded.
+    auto& journal = coreDiagram->GetJournal();
+    journal.SetObserver(nullptr);
+    int edits = 0;
+    bool failed = false;
+    for (auto& entry : entries)
+    {
+        RecoveryRecord record(std::move(entry.data));
+        if (entry.type == CoreRecovery::EntryType::Command || entry.type == CoreRecovery::EntryType::History)
+        {
+            // Names and ports are checked against the diagram before the edit is applied.
+            auto command = ReadCommand(record);
+            if (command == nullptr || (entry.type == CoreRecovery::EntryType::Command && command->IsValid(true) == false))
+            {
+                failed = true;
+                break;
+            }
+            if (entry.type == CoreRecovery::EntryType::Command)
+            {
+                command->Redo();
+                edits += 1;
+            }
+            journal.Record(std::move(command));
+        }
+        else if (entry.type == CoreRecovery::EntryType::Commit)
+        {
+            journal.Commit();
+        }
+        else if (entry.type == CoreRecovery::EntryType::Base)
+        {
+            journal.Rewind(static_cast<size_t>(record.Get<uint64_t>()));
+            journal.MarkSaved();
+        }
+        else if (entry.type == CoreRecovery::EntryType::Undo && coreDiagram->Undo() == false)
+        {
+            failed = true;
+            break;
+        }
+        else if (entry.type == CoreRecovery::EntryType::Redo && coreDiagram->Redo() == false)
+        {
+            failed = true;
+            break;
+        }
+    }
+    if (failed == true)
+    {
+        // The edits replayed so far are only in memory, a step may be half undone so the history goes.
+        ResetHistory();
+        journal.MarkUnsaved();
+        StartRecovery();
+        Notifier::Add(Notif(Notif::Type::WARNING, "Recovery incomplete", "An edit of the journal could not be read or does not match the project, save the project.", 5.0f));
+    }
+    else
+    {
+        StartRecovery(data);
+        Notifier::Add(Notif(Notif::Type::SUCCESS, "Recovered", std::to_string(edits) + " edits replayed.", 5.0f));
+    }
+    if (recovery.GetPath() != recoveryFile)
+    {
+        std::error_code code;
+        std::filesystem::remove(recoveryFile, code);
+    }
+    SetAsterisk(journal.IsSaved() == false);
+}
+
+std::unique_ptr<CoreCommand> MyApp::ReadCommand(RecoveryRecord& record)
 {
-    docs.clear();
-    iCurrentDoc = 0;
-    iSavedDoc = 0;
-    docs.emplace_back(CreateDoc());
+    const std::string type = record.GetString();
+    if (type == "settings")
+    {
+        std::unique_ptr<CoreCommand> command = SettingsEdit::Read(*this, record);
+        return record.IsValid() == true ? std::move(command) : nullptr;
+    }
+    return coreDiagram->ReadCommand(type, record);
 }
 
 void MyApp::DrawAbout()
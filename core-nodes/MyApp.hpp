@@ -9,15 +9,18 @@
 
 #include "gui-app-template/GuiApp.hpp"
 #include "CoreDiagram.hpp"
+#include "CoreRunner.hpp"
+#include "CoreWriter.hpp"
+#include "FileDialog.hpp"
 #include <memory>
-#include <deque>
 #include <iostream>
+#include <chrono>
 
 class MyApp : public GuiApp
 {
 public:
     MyApp();
-    ~MyApp() final = default;
+    ~MyApp() final;
 
     void Update() override;
     void TestBasic() const;
@@ -37,6 +40,16 @@ private:
     void MenuView();
     void MenuHelp();
 
+    SimSettings simSettings;
+    bool simModifFlag = false;
+    void DrawSimulation();
+    void DrawSignals();
+    void DrawPacing(const PacerStats& stats) const;
+    void RunSimulation();
+    void PollSimulation();
+    CoreRunner runner;
+    std::vector<std::string> signalNames; // Signals of the running program.
+
     FileDialog fileDialog;
     bool fileDialogOpen = false;
     void DrawFileDialog();
@@ -44,22 +57,40 @@ private:
     bool hasFile = false;
     std::filesystem::path filePath;
     void NewProject();
+    void ResetProject();                    // Empty project, without a journal.
     void OpenProject();
     bool openSaveModal = false;
     int stateSaveModal = 0; // 1: from new, 2: from open, 3: from exit.
     void DrawSaveModal();
-    pugi::xml_document CreateDoc() const;
-    void SaveProject(bool saveAs = false);
-    void SaveToFile(const std::string& fName, const std::string& fPath);
+    std::unique_ptr<CoreBinaryWriter> CreateSnapshot() const; // Records of the project, saved in either format.
+    bool binaryFile = false;                // Format of the open project.
+    bool saveBinary = false;                // Format chosen for the save dialog.
+    bool savingBinary = false;
+    void SaveProject(bool saveAs = false, bool binary = false);
+    void SaveToFile(const std::string& fName, const std::string& fPath, bool binary);
+    void PollSave();
+    CoreWriter writer;
+    std::string savingName;                 // Title of the project being written.
+    unsigned int projectNum = 0;            // Changes when another project is opened.
+    unsigned int savingProjectNum = 0;
     void LoadDoc(const pugi::xml_document* doc);
+    void LoadBinary(const CoreBinaryReader& reader);
+    bool LoadProject(const std::filesystem::path& path);
     void LoadFromFile();
 
-    std::deque<pugi::xml_document> docs;
-    int iCurrentDoc{ 0 };
-    int iSavedDoc{ 0 };
-    const int maxSavedDoc{ 20 };
+    SimSettings simSettingsRecorded; // Settings as of the last recorded edit.
+    class SettingsEdit;
     void UndoRedoSave();
-    void ResetDocDeque();
+    void ResetHistory();
+
+    CoreRecovery recovery;                  // Edits since the project file was written.
+    std::string recoveryFile;               // Journal offered for recovery.
+    bool openRecoveryModal = false;
+    void StartRecovery(const std::string& entries = std::string());
+    bool OfferRecovery(const std::filesystem::path& path); // False if the journal has nothing to recover.
+    void DrawRecoveryModal();
+    void RecoverProject();
+    std::unique_ptr<CoreCommand> ReadCommand(RecoveryRecord& record);
 
     bool openAbout = false;
     void DrawAbout();
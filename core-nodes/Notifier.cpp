@@ -8,10 +8,18 @@
 ******************************************************************************************/
 
 #include "Notifier.hpp"
+#include <iostream>
+#include <chrono>
+
+double Notif::Now()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
 
 Notif::Status Notif::GetStatus() const
 {
-    const auto elapsedTime = ImGui::GetTime() - notifCreateTime; // [s]
+    const auto elapsedTime = Now() - notifCreateTime; // [s]
     if (elapsedTime > fadeInTime + onTime + fadeOutTime) { return Status::OFF; }
     else if (elapsedTime > fadeInTime + onTime) { return Status::FADEOUT; }
     else if (elapsedTime > fadeInTime) { return Status::ON; }
@@ -39,7 +47,7 @@ std::string Notif::GetTypeName() const
 float Notif::GetFadeValue() const
 {
     const auto status = GetStatus();
-    const auto elapsedTime = static_cast<float>(ImGui::GetTime() - notifCreateTime); // [s]
+    const auto elapsedTime = static_cast<float>(Now() - notifCreateTime); // [s]
     if (status == Status::FADEIN)
     {
         return (elapsedTime / fadeInTime) * opacity;
@@ -63,61 +71,25 @@ ImColor Notif::GetColor() const
 Notif::Notif(Type type, const std::string& title, const std::string& content, float onTime) :
     type(type), title(title), content(content), onTime(onTime)
 {
-    notifCreateTime = static_cast<float>(ImGui::GetTime());
+    notifCreateTime = static_cast<float>(Now());
 }
 
-void Notifier::DrawNotifications()
+void Notifier::AddNotif(const Notif & notif)
 {
-    float height = 0.0f;
-    for (int i = 0; i < notifs.size(); i++)
+    if (console == true)
     {
-        auto notif = &notifs[i];
-        if (notif->GetStatus() == Notif::Status::OFF)
-        {
-            RemoveNotif(i);
-            continue;
-        }
-        std::string notifName = "Notif" + std::to_string(i);
-        const auto fadeValue = notif->GetFadeValue();
-        ImGui::SetNextWindowBgAlpha(fadeValue);
-        ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, rounding);
-        ImGui::PushStyleColor(ImGuiCol_WindowBg, backgroundColor);
-        const auto rightCorner = ImVec2(ImGui::GetMainViewport()->Pos.x + ImGui::GetMainViewport()->Size.x, ImGui::GetMainViewport()->Pos.y + ImGui::GetMainViewport()->Size.y);
-        ImGui::SetNextWindowPos(ImVec2(rightCorner.x - xPadding, rightCorner.y - yPadding - height), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
-        ImGui::Begin(notifName.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoFocusOnAppearing);
-        ImGui::PushTextWrapPos(ImGui::GetMainViewport()->Size.x * wrapRatio);
-        const auto icon = notif->GetIcon();
-        auto iconColor = notif->GetColor();
-        iconColor.Value.w = fadeValue;
-        ImGui::TextColored(iconColor, icon.c_str());
-        ImGui::SameLine();
-        if (const auto title = notif->GetTitle(); title.empty() == false)
-        {
-            ImGui::TextColored(ImVec4(0.0f, 0.0f, 0.0f, 1.0f), title.c_str());
-        }
-        else if (const auto typeName = notif->GetTypeName(); typeName.empty() == false)
+        // No window, e.g. batch runs.
+        std::cerr << notif.GetTypeName() << ": " << notif.GetTitle();
+        if (notif.GetContent().empty() == false)
         {
-            ImGui::TextColored(notif->GetColor(), typeName.c_str());
+            std::cerr << " " << notif.GetContent();
         }
-        if (const auto content = notif->GetContent(); content.empty() == false)
-        {
-            ImGui::Separator();
-            ImGui::TextColored(ImVec4(0.0f, 0.0f, 0.0f, 1.0f), content.c_str());
-        }
-        ImGui::PopTextWrapPos();
-        height += ImGui::GetWindowHeight() + yMessagePadding;
-        ImGui::End();
-        ImGui::PopStyleVar();
-        ImGui::PopStyleColor();
+        std::cerr << std::endl;
+        return;
     }
-    heightNotifs = height;
-}
-
-void Notifier::AddNotif(const Notif & notif)
-{
-    if (heightNotifs >= ImGui::GetMainViewport()->Size.y * 0.8f)
+    if (heightNotifs >= heightMax)
     {
         RemoveNotif(0);
     }
     notifs.push_back(notif);
-}
+}
\ No newline at end of file
@@ -52,6 +52,7 @@ private:
     float fadeOutTime{ 0.150f };
     float opacity{ 1.0f };
     float notifCreateTime{ 0.0f };
+    static double Now();
 };
 
 class Notifier
@@ -67,6 +68,7 @@ public:
     }
     static void Add(const Notif& notif) { Get().AddNotif(notif); }
     static void Draw() { Get().DrawNotifications(); }
+    static void SetConsole(bool enable) { Get().console = enable; }
     void DrawNotifications();
 
 private:
@@ -80,6 +82,8 @@ private:
     ImVec4 backgroundColor = ImVec4(0.886f, 0.929f, 0.969f, 0.4f);
     std::vector<Notif> notifs;
     float heightNotifs{ 0.0f };
+    float heightMax{ 1000.0f };
+    bool console = false;       // Print to the console instead of drawing.
     void RemoveNotif(int i) { notifs.erase(notifs.begin() + i); }
 };
 
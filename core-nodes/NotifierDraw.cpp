@@ -0,0 +1,58 @@
+/******************************************************************************************
+*                                                                                         *
+*    Notifier Draw                                                                        *
+*                                                                                         *
+*    Copyright (c) 2023 Onur AKIN <https://github.com/onurae>                             *
+*    Licensed under the MIT License.                                                      *
+*                                                                                         *
+******************************************************************************************/
+
+#include "Notifier.hpp"
+
+void Notifier::DrawNotifications()
+{
+    float height = 0.0f;
+    for (int i = 0; i < notifs.size(); i++)
+    {
+        auto notif = &notifs[i];
+        if (notif->GetStatus() == Notif::Status::OFF)
+        {
+            RemoveNotif(i);
+            continue;
+        }
+        std::string notifName = "Notif" + std::to_string(i);
+        const auto fadeValue = notif->GetFadeValue();
+        ImGui::SetNextWindowBgAlpha(fadeValue);
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, rounding);
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, backgroundColor);
+        const auto rightCorner = ImVec2(ImGui::GetMainViewport()->Pos.x + ImGui::GetMainViewport()->Size.x, ImGui::GetMainViewport()->Pos.y + ImGui::GetMainViewport()->Size.y);
+        ImGui::SetNextWindowPos(ImVec2(rightCorner.x - xPadding, rightCorner.y - yPadding - height), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+        ImGui::Begin(notifName.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoFocusOnAppearing);
+        ImGui::PushTextWrapPos(ImGui::GetMainViewport()->Size.x * wrapRatio);
+        const auto icon = notif->GetIcon();
+        auto iconColor = notif->GetColor();
+        iconColor.Value.w = fadeValue;
+        ImGui::TextColored(iconColor, icon.c_str());
+        ImGui::SameLine();
+        if (const auto title = notif->GetTitle(); title.empty() == false)
+        {
+            ImGui::TextColored(ImVec4(0.0f, 0.0f, 0.0f, 1.0f), title.c_str());
+        }
+        else if (const auto typeName = notif->GetTypeName(); typeName.empty() == false)
+        {
+            ImGui::TextColored(notif->GetColor(), typeName.c_str());
+        }
+        if (const auto content = notif->GetContent(); content.empty() == false)
+        {
+            ImGui::Separator();
+            ImGui::TextColored(ImVec4(0.0f, 0.0f, 0.0f, 1.0f), content.c_str());
+        }
+        ImGui::PopTextWrapPos();
+        height += ImGui::GetWindowHeight() + yMessagePadding;
+        ImGui::End();
+        ImGui::PopStyleVar();
+        ImGui::PopStyleColor();
+    }
+    heightNotifs = height;
+    heightMax = ImGui::GetMainViewport()->Size.y * 0.8f;
+}
\ No newline at end of file
@@ -21,23 +21,18 @@ void TestNode::Build()
     BuildGeometry();
 }
 
-void TestNode::DrawProperties(const std::vector<CoreNode*>& coreNodeVec)
+void TestNode::Compile(NodeKernel& kernel) const
 {
-    ImGui::Text(GetLibName().c_str());
-    ImGui::Separator();
-    ImGui::Text("This is a test module explanation.");
-    ImGui::NewLine();
-    ImGui::Text("Parameters");
-    ImGui::Separator();
-    EditName(coreNodeVec);
-    parameter1.Draw(modifFlag);
-    parameter2.Draw(modifFlag);
+    kernel.output = &TestNode::Output;
+    kernel.param = { parameter1.Get(), parameter2.Get() };
+    kernel.paramName = { parameter1.GetName(), parameter2.GetName() };
 }
 
-void TestNode::SaveProperties(pugi::xml_node& xmlNode)
+void TestNode::Output(const StepArgs& args)
 {
-    SaveDouble(xmlNode, "parameter1", parameter1.Get());
-    SaveDouble(xmlNode, "parameter2", parameter2.Get());
+    args.out[0] = args.In(2);
+    args.out[1] = args.param[0] * args.In(1) + args.param[1] * args.In(3);
+    args.out[2] = args.In(0);
 }
 
 void TestNode::LoadProperties(const pugi::xml_node& xmlNode)
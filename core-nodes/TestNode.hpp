@@ -19,11 +19,13 @@ public:
     ~TestNode() override = default;
 
     void Build() override;
-    void DrawProperties(const std::vector<CoreNode*>& coreNodeVec) override;
+    void Compile(NodeKernel& kernel) const override;
+    std::string GetDescription() const override { return "This is a test module explanation."; }
+    std::vector<NodeParamDouble*> GetParams() override { return { &parameter1, &parameter2 }; }
 
-    void SaveProperties(pugi::xml_node& xmlNode) override;
     void LoadProperties(const pugi::xml_node& xmlNode) override;
 private:
+    static void Output(const StepArgs& args);
     NodeParamDouble parameter1{ "parameter1", 1.234 };
     NodeParamDouble parameter2{ "parameter2", 1.234 };
 };